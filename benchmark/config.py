@@ -0,0 +1,58 @@
+import argparse
+
+from json import dump
+
+
+def get_configuration(channel_count, n_sdu_count, pdu_id_base=0, pdu_id_stride=1):
+    """
+    returns a configuration holding channel_count channels of n_sdu_count receivers each, N-SDU identifiers being
+    allocated from pdu_id_base every pdu_id_stride identifiers (contiguously by default). timeouts are large enough to
+    never expire during a benchmark run.
+    """
+    return {
+        'configurations': [
+            {
+                'padding_byte': 255,
+                'main_function_period': 0.001,
+                'channels': [
+                    {
+                        'mode': 'CANTP_MODE_FULL_DUPLEX',
+                        'receivers': [
+                            {
+                                'block_size': 0,
+                                'wait_for_transmission_maximum': 1,
+                                'minimum_separation_time': 0.0,
+                                'N_Ar_timeout': 1000.0,
+                                'N_Br_timeout': 1000.0,
+                                'N_Cr_timeout': 1000.0,
+                                'network_service_data_unit_identifier':
+                                    pdu_id_base + (channel * n_sdu_count + n_sdu) * pdu_id_stride,
+                                'addressing_format': 'CANTP_STANDARD',
+                                'network_service_data_unit_reference': channel * n_sdu_count + n_sdu,
+                                'communication_type': 'CANTP_PHYSICAL'
+                            } for n_sdu in range(n_sdu_count)
+                        ]
+                    } for channel in range(channel_count)
+                ]
+            }
+        ]
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='CAN transport layer benchmark configuration generator')
+
+    parser.add_argument('output', help='output configuration file path')
+    parser.add_argument('-channels', type=int, default=8, help='number of channels')
+    parser.add_argument('-n_sdus', type=int, default=64, help='number of N-SDUs per channel')
+    parser.add_argument('-pdu_id_base', type=int, default=0, help='identifier of the first N-SDU')
+    parser.add_argument('-pdu_id_stride', type=int, default=1, help='gap between two consecutive N-SDU identifiers')
+
+    args = parser.parse_args()
+
+    with open(args.output, 'w') as fp:
+        dump(get_configuration(args.channels, args.n_sdus, args.pdu_id_base, args.pdu_id_stride), fp, indent=2)
+
+
+if __name__ == '__main__':
+    main()
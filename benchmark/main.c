@@ -0,0 +1,209 @@
+/**
+ * @file main.c
+ *
+ * @brief measures the cost of CanTp_MainFunction while CANTP_BENCHMARK_N_SDU_CNT segmented
+ * receptions are ongoing (each of them waiting for its next CF), in time and, if the hardware
+ * performance counters are available, in L1 data cache and last level cache misses per tick.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif /* #if defined(__linux__) */
+
+#include "CanTp.h"
+#include "CanTp_Cbk.h"
+#include "CanTp_PBcfg.h"
+
+#ifndef CANTP_BENCHMARK_N_SDU_CNT
+#define CANTP_BENCHMARK_N_SDU_CNT (512u)
+#endif /* #ifndef CANTP_BENCHMARK_N_SDU_CNT */
+
+#define CANTP_BENCHMARK_ROUND_CNT (20u)
+
+#define CANTP_BENCHMARK_TICK_CNT (500u)
+
+typedef struct
+{
+    int fd;
+    const char *name;
+} counter_type;
+
+static void open_counter(counter_type *counter, const char *name, uint32 type, uint64_t config)
+{
+    counter->fd = -1;
+    counter->name = name;
+
+#if defined(__linux__)
+
+    struct perf_event_attr attr;
+
+    memset(&attr, 0x00, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    counter->fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+#else
+
+    (void)type;
+    (void)config;
+
+#endif /* #if defined(__linux__) */
+}
+
+static void start_counter(const counter_type *counter)
+{
+#if defined(__linux__)
+
+    if (counter->fd >= 0)
+    {
+        (void)ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+        (void)ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+#endif /* #if defined(__linux__) */
+}
+
+static uint64_t stop_counter(const counter_type *counter)
+{
+    uint64_t value = 0x00u;
+
+#if defined(__linux__)
+
+    if (counter->fd >= 0)
+    {
+        (void)ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(counter->fd, &value, sizeof(value)) != sizeof(value))
+        {
+            value = 0x00u;
+        }
+    }
+
+#endif /* #if defined(__linux__) */
+
+    return value;
+}
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief starts a segmented reception on each N-SDU and brings it to the state where it waits for
+ * its first CF (FC.CTS transmitted and confirmed).
+ */
+static void start_receptions(void)
+{
+    uint8 ff[] = {0x1Fu, 0xFFu, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u};
+    PduInfoType pdu_info;
+    PduIdType pdu_id;
+
+    pdu_info.SduDataPtr = &ff[0x00u];
+    pdu_info.MetaDataPtr = NULL_PTR;
+    pdu_info.SduLength = sizeof(ff);
+
+    for (pdu_id = 0x00u; pdu_id < (PduIdType)(CANTP_BENCHMARK_N_SDU_CNT); pdu_id++)
+    {
+        CanTp_RxIndication(pdu_id, &pdu_info);
+    }
+
+    CanTp_MainFunction();
+
+    for (pdu_id = 0x00u; pdu_id < (PduIdType)(CANTP_BENCHMARK_N_SDU_CNT); pdu_id++)
+    {
+        CanTp_TxConfirmation(pdu_id, E_OK);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    counter_type counters[2];
+    uint64_t misses[2] = {0x00u, 0x00u};
+    uint64_t elapsed = 0x00u;
+    uint64_t start;
+    uint32 round;
+    uint32 tick;
+    uint32 idx;
+    const uint32 tick_cnt = CANTP_BENCHMARK_ROUND_CNT * CANTP_BENCHMARK_TICK_CNT;
+
+    (void)argc;
+    (void)argv;
+
+    open_counter(&counters[0x00u], "L1D read misses:", PERF_TYPE_HW_CACHE,
+                 PERF_COUNT_HW_CACHE_L1D |
+                 (PERF_COUNT_HW_CACHE_OP_READ << 8u) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16u));
+    open_counter(&counters[0x01u], "LLC misses:", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+
+    for (round = 0x00u; round < CANTP_BENCHMARK_ROUND_CNT; round++)
+    {
+        CanTp_Init(&CanTp_Config[0x00u]);
+        start_receptions();
+
+        for (idx = 0x00u; idx < 0x02u; idx++)
+        {
+            start_counter(&counters[idx]);
+        }
+
+        start = get_time_ns();
+
+        for (tick = 0x00u; tick < CANTP_BENCHMARK_TICK_CNT; tick++)
+        {
+            CanTp_MainFunction();
+        }
+
+        elapsed += get_time_ns() - start;
+
+        for (idx = 0x00u; idx < 0x02u; idx++)
+        {
+            misses[idx] += stop_counter(&counters[idx]);
+        }
+
+        CanTp_Shutdown();
+    }
+
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON)
+    printf("configuration variant:     pre-compile\n");
+#else
+    printf("configuration variant:     post-build\n");
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) */
+    printf("active N-SDUs:             %u\n", (unsigned)(CANTP_BENCHMARK_N_SDU_CNT));
+    printf("time per tick:             %.1f ns\n", (double)elapsed / (double)tick_cnt);
+
+    for (idx = 0x00u; idx < 0x02u; idx++)
+    {
+        if (counters[idx].fd >= 0)
+        {
+            printf("%-26s %.1f per tick\n",
+                   counters[idx].name, (double)misses[idx] / (double)tick_cnt);
+        }
+        else
+        {
+            printf("%-26s unavailable (no hardware performance counter)\n", counters[idx].name);
+        }
+    }
+
+    return 0;
+}
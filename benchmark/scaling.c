@@ -0,0 +1,183 @@
+/**
+ * @file scaling.c
+ *
+ * @brief measures how the cost of the module scales with the size of the configuration: the time
+ * spent in CanTp_Init per configured N-SDU, and the time spent per call in CanTp_RxIndication (SF
+ * and CF) and per tick in CanTp_MainFunction, the last three being measured on a fixed number of
+ * N-SDUs spread over the CANTP_BENCHMARK_N_SDU_CNT N-SDUs of the configuration, whose identifiers
+ * are allocated every CANTP_BENCHMARK_PDU_ID_STRIDE identifiers from CANTP_BENCHMARK_PDU_ID_BASE.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "CanTp.h"
+#include "CanTp_Cbk.h"
+#include "CanTp_PBcfg.h"
+
+#ifndef CANTP_BENCHMARK_N_SDU_CNT
+#define CANTP_BENCHMARK_N_SDU_CNT (512u)
+#endif /* #ifndef CANTP_BENCHMARK_N_SDU_CNT */
+
+#ifndef CANTP_BENCHMARK_PDU_ID_BASE
+#define CANTP_BENCHMARK_PDU_ID_BASE (0u)
+#endif /* #ifndef CANTP_BENCHMARK_PDU_ID_BASE */
+
+#ifndef CANTP_BENCHMARK_PDU_ID_STRIDE
+#define CANTP_BENCHMARK_PDU_ID_STRIDE (1u)
+#endif /* #ifndef CANTP_BENCHMARK_PDU_ID_STRIDE */
+
+#define CANTP_BENCHMARK_ROUND_CNT (20u)
+
+/* number of N-SDUs on which the callbacks are measured, whatever the size of the configuration. */
+#define CANTP_BENCHMARK_ACTIVE_CNT (16u)
+
+/* number of SFs and CFs received per measured N-SDU and per round, the FF announcing 4095 bytes and
+ * less than 256 CFs being received, so that the receptions never wait for a FC confirmation. */
+#define CANTP_BENCHMARK_CF_CNT (240u)
+
+#define CANTP_BENCHMARK_TICK_CNT (500u)
+
+static PduIdType active_pdu_ids[CANTP_BENCHMARK_ACTIVE_CNT];
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief spreads the measured N-SDUs evenly over the whole configuration, so that both the first
+ * and the last identifiers are exercised.
+ */
+static void select_active_pdu_ids(void)
+{
+    uint32 idx;
+    uint32 n_sdu_idx;
+
+    for (idx = 0x00u; idx < CANTP_BENCHMARK_ACTIVE_CNT; idx++)
+    {
+        n_sdu_idx = (idx * ((CANTP_BENCHMARK_N_SDU_CNT) - 0x01u)) / (CANTP_BENCHMARK_ACTIVE_CNT - 0x01u);
+        active_pdu_ids[idx] = (PduIdType)((CANTP_BENCHMARK_PDU_ID_BASE) +
+                                          (n_sdu_idx * (CANTP_BENCHMARK_PDU_ID_STRIDE)));
+    }
+}
+
+/**
+ * @brief indicates the same frame on each measured N-SDU and returns the time spent in
+ * CanTp_RxIndication.
+ */
+static uint64_t indicate(uint8 *pFrame)
+{
+    PduInfoType pdu_info;
+    uint64_t start;
+    uint32 idx;
+
+    pdu_info.SduDataPtr = pFrame;
+    pdu_info.MetaDataPtr = NULL_PTR;
+    pdu_info.SduLength = 0x08u;
+
+    start = get_time_ns();
+
+    for (idx = 0x00u; idx < CANTP_BENCHMARK_ACTIVE_CNT; idx++)
+    {
+        CanTp_RxIndication(active_pdu_ids[idx], &pdu_info);
+    }
+
+    return get_time_ns() - start;
+}
+
+/**
+ * @brief starts a segmented reception on each measured N-SDU and brings it to the state where it
+ * waits for its first CF (FC.CTS transmitted and confirmed).
+ */
+static void start_receptions(void)
+{
+    uint8 ff[] = {0x1Fu, 0xFFu, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u};
+    uint32 idx;
+
+    (void)indicate(&ff[0x00u]);
+
+    CanTp_MainFunction();
+
+    for (idx = 0x00u; idx < CANTP_BENCHMARK_ACTIVE_CNT; idx++)
+    {
+        CanTp_TxConfirmation(active_pdu_ids[idx], E_OK);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint8 sf[] = {0x07u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u};
+    uint8 cf[] = {0x20u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u};
+    uint64_t init_elapsed = 0x00u;
+    uint64_t sf_elapsed = 0x00u;
+    uint64_t cf_elapsed = 0x00u;
+    uint64_t tick_elapsed = 0x00u;
+    uint64_t start;
+    uint32 round;
+    uint32 idx;
+    const uint32 call_cnt = CANTP_BENCHMARK_ROUND_CNT * CANTP_BENCHMARK_CF_CNT * CANTP_BENCHMARK_ACTIVE_CNT;
+    const uint32 tick_cnt = CANTP_BENCHMARK_ROUND_CNT * CANTP_BENCHMARK_TICK_CNT;
+
+    (void)argc;
+    (void)argv;
+
+    select_active_pdu_ids();
+
+    for (round = 0x00u; round < CANTP_BENCHMARK_ROUND_CNT; round++)
+    {
+        start = get_time_ns();
+        CanTp_Init(&CanTp_Config[0x00u]);
+        init_elapsed += get_time_ns() - start;
+
+        /* single frame receptions, completed within the indication. */
+        for (idx = 0x00u; idx < CANTP_BENCHMARK_CF_CNT; idx++)
+        {
+            sf_elapsed += indicate(&sf[0x00u]);
+            CanTp_MainFunction();
+        }
+
+        /* segmented receptions, each CF being indicated in sequence on all the measured N-SDUs. */
+        start_receptions();
+
+        for (idx = 0x00u; idx < CANTP_BENCHMARK_CF_CNT; idx++)
+        {
+            cf[0x00u] = (uint8)(0x20u | ((idx + 0x01u) & 0x0Fu));
+            cf_elapsed += indicate(&cf[0x00u]);
+            CanTp_MainFunction();
+        }
+
+        /* the receptions are still waiting for their remaining CFs. */
+        start = get_time_ns();
+
+        for (idx = 0x00u; idx < CANTP_BENCHMARK_TICK_CNT; idx++)
+        {
+            CanTp_MainFunction();
+        }
+
+        tick_elapsed += get_time_ns() - start;
+
+        CanTp_Shutdown();
+    }
+
+    printf("configured N-SDUs:         %u\n", (unsigned)(CANTP_BENCHMARK_N_SDU_CNT));
+    printf("N-SDU identifiers:         0x%04X to 0x%04X\n",
+           (unsigned)(CANTP_BENCHMARK_PDU_ID_BASE),
+           (unsigned)((CANTP_BENCHMARK_PDU_ID_BASE) +
+                      (((CANTP_BENCHMARK_N_SDU_CNT) - 0x01u) * (CANTP_BENCHMARK_PDU_ID_STRIDE))));
+    printf("init time per N-SDU:       %.1f ns\n",
+           (double)init_elapsed / ((double)CANTP_BENCHMARK_ROUND_CNT * (double)(CANTP_BENCHMARK_N_SDU_CNT)));
+    printf("SF indication time:        %.1f ns\n", (double)sf_elapsed / (double)call_cnt);
+    printf("CF indication time:        %.1f ns\n", (double)cf_elapsed / (double)call_cnt);
+    printf("time per tick (%2u active): %.1f ns\n",
+           (unsigned)CANTP_BENCHMARK_ACTIVE_CNT, (double)tick_elapsed / (double)tick_cnt);
+
+    return 0;
+}
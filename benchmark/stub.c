@@ -0,0 +1,99 @@
+/**
+ * @file stub.c
+ *
+ * @brief lower and upper layer stubs shared by the benchmarks: transmissions are always accepted,
+ * errors are ignored and the upper layer always provides a 4095 bytes buffer.
+ */
+
+#include "CanIf.h"
+#include "Det.h"
+#include "PduR.h"
+
+Std_ReturnType CanIf_Transmit(PduIdType txPduId, const PduInfoType *pPduInfo)
+{
+    (void)txPduId;
+    (void)pPduInfo;
+
+    return E_OK;
+}
+
+Std_ReturnType Det_ReportError(uint16 moduleId, uint8 instanceId, uint8 apiId, uint8 errorId)
+{
+    (void)moduleId;
+    (void)instanceId;
+    (void)apiId;
+    (void)errorId;
+
+    return E_OK;
+}
+
+Std_ReturnType Det_ReportRuntimeError(uint16 moduleId, uint8 instanceId, uint8 apiId, uint8 errorId)
+{
+    (void)moduleId;
+    (void)instanceId;
+    (void)apiId;
+    (void)errorId;
+
+    return E_OK;
+}
+
+Std_ReturnType Det_ReportTransientFault(uint16 moduleId, uint8 instanceId, uint8 apiId, uint8 faultId)
+{
+    (void)moduleId;
+    (void)instanceId;
+    (void)apiId;
+    (void)faultId;
+
+    return E_OK;
+}
+
+void PduR_CanTpRxIndication(PduIdType rxPduId, Std_ReturnType result)
+{
+    (void)rxPduId;
+    (void)result;
+}
+
+void PduR_CanTpTxConfirmation(PduIdType txPduId, Std_ReturnType result)
+{
+    (void)txPduId;
+    (void)result;
+}
+
+BufReq_ReturnType PduR_CanTpCopyRxData(PduIdType rxPduId,
+                                       const PduInfoType *pPduInfo,
+                                       PduLengthType *pBuffer)
+{
+    (void)rxPduId;
+    (void)pPduInfo;
+
+    *pBuffer = 0x0FFFu;
+
+    return BUFREQ_OK;
+}
+
+BufReq_ReturnType PduR_CanTpCopyTxData(PduIdType txPduId,
+                                       const PduInfoType *pPduInfo,
+                                       const RetryInfoType *pRetryInfo,
+                                       PduLengthType *pAvailableData)
+{
+    (void)txPduId;
+    (void)pPduInfo;
+    (void)pRetryInfo;
+    (void)pAvailableData;
+
+    return BUFREQ_OK;
+}
+
+BufReq_ReturnType PduR_CanTpStartOfReception(PduIdType pduId,
+                                             const PduInfoType *pPduInfo,
+                                             PduLengthType tpSduLength,
+                                             PduLengthType *pBufferSize)
+{
+    (void)pduId;
+    (void)pPduInfo;
+    (void)tpSduLength;
+
+    *pBufferSize = 0x0FFFu;
+
+    return BUFREQ_OK;
+}
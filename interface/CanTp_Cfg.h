@@ -21,12 +21,4 @@
 #error incompatible AUTOSAR release minor version
 #endif
 
-#ifndef CANTP_MAX_NUM_OF_CHANNEL
-#define CANTP_MAX_NUM_OF_CHANNEL (0x10u)
-#endif
-
-#ifndef CANTP_MAX_NUM_OF_N_SDU
-#define CANTP_MAX_NUM_OF_N_SDU (0x10u)
-#endif
-
 #endif /* #ifndef CANTP_CFG_H */
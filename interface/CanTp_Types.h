@@ -31,6 +31,51 @@ extern "C"
 /** @} */
 
 
+/*-----------------------------------------------------------------------------------------------*/
+/* global constant macros.                                                                       */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_TYPES_H
+ * @{
+ */
+
+/**
+ * @brief the N-SDU is configured in reception (see @ref CanTp_PduIdMapType).
+ */
+#define CANTP_DIRECTION_RX (0x01u)
+
+/**
+ * @brief the N-SDU is configured in transmission (see @ref CanTp_PduIdMapType).
+ */
+#define CANTP_DIRECTION_TX (0x02u)
+
+/**
+ * @brief maximum size of a CAN FD frame.
+ */
+#define CANTP_CAN_FD_FRAME_SIZE (0x40u)
+
+/**
+ * @brief number of timers of an N-SDU (N_As, N_Bs, N_Cs, N_Ar, N_Br, N_Cr and STmin).
+ */
+#define CANTP_NUM_OF_TIMER_PER_N_SDU (0x07u)
+
+/**
+ * @brief maximum number of CFs of a Tx N-SDU handed over to CanIf and not yet confirmed (see
+ * @ref CanTp_TxNSduType::txWindow).
+ */
+#define CANTP_MAX_TX_WINDOW (0x20u)
+
+/**
+ * @brief size of the CAN_ID_32 meta data item exchanged with CanIf and PduR by the dynamically
+ * addressed N-SDUs (see @ref CanTp_RxNSduType::dynamicAddressing): the CAN identifier, least
+ * significant byte first.
+ */
+#define CANTP_META_DATA_SIZE (0x04u)
+
+/** @} */
+
+
 /*-----------------------------------------------------------------------------------------------*/
 /* global data type definitions (typedef, struct).                                               */
 /*-----------------------------------------------------------------------------------------------*/
@@ -121,6 +166,22 @@ typedef enum
 } CanTp_ComTypeType;
 
 
+typedef enum
+{
+    /**
+     * @brief frames are only requested to the lower layer by the main function
+     */
+        CANTP_DEFERRED_PROCESSING,
+
+    /**
+     * @brief frames are requested to the lower layer directly from the indication/confirmation
+     * callbacks when possible, without waiting for the next call of the main function
+     */
+        CANTP_IMMEDIATE_PROCESSING
+
+} CanTp_ProcessingModeType;
+
+
 typedef struct
 {
     uint8 nSa; /* CanTpNSa. */
@@ -189,6 +250,44 @@ typedef struct
     const CanTp_RxPaddingActivationType padding; /* CanTpRxPaddingActivation. */
     const CanTp_ComTypeType taType; /* CanTpRxTaType. */
     const PduIdType rxNSduRef; /* CanTpRxNSduRef. */
+
+    /**
+     * @brief maximum data link layer data length (RX_DL) accepted for this RxNSdu: 8 for CAN 2.0,
+     * or one of 12, 16, 20, 24, 32, 48 and 64 for CAN FD. received N-PDUs longer than this value
+     * are ignored.
+     */
+    const uint8 rxDl;
+
+    /**
+     * @brief if TRUE, a FC rejected by CanIf_Transmit is transmitted again on the next calls of
+     * CanTp_MainFunction (or @ref CanTp_TxMailboxFree) until N_Ar expires, instead of terminating
+     * the reception (see SWS_CanTp_00342).
+     */
+    const boolean transmitRetry;
+
+    /**
+     * @brief if TRUE, the upper layer reports the release of buffer space through @ref
+     * CanTp_RxBufferAvailable, and PduR_CanTpCopyRxData is not polled while N_Br is running (see
+     * SWS_CanTp_00222).
+     */
+    const boolean bufferNotification;
+
+    /**
+     * @brief size of the staging buffer in which the payload of the received frames is accumulated
+     * before being handed over to the upper layer, at the end of each block, at the end of the
+     * reception or once the staging buffer is full, instead of one PduR_CanTpCopyRxData call per
+     * frame (0: no staging buffer, otherwise at least RX_DL).
+     */
+    const uint16 rxStagingSize;
+
+    /**
+     * @brief if TRUE, N_SA and N_TA are not fixed by the configuration but taken from the CAN_ID_32
+     * meta data of each received N-PDU (N_TA in bits 8 to 15, N_SA in bits 0 to 7), and each peer
+     * is served by its own entry of the connection pool (see @ref CanTp_ConfigType::pPeer). only
+     * supported by the CANTP_NORMALFIXED and CANTP_MIXED29BIT addressing formats, without staging
+     * buffer.
+     */
+    const boolean dynamicAddressing;
 } CanTp_RxNSduType; /* CanTpRxNSdu. */
 
 
@@ -251,6 +350,63 @@ typedef struct
      */
     const uint32 txNSduRef; /* CanTpTxNSduRef. */
 
+    /**
+     * @brief maximum number of consecutive frames transmitted per main function period. when the
+     * confirmation of a CF is received and STmin has already elapsed, the next CF is sent directly
+     * from @ref CanTp_TxConfirmation until this budget is exhausted (0 or 1: one CF per period).
+     */
+    const uint8 burstSize;
+
+    /**
+     * @brief data link layer data length (TX_DL) used for the transmission of this TxNSdu: 8 for
+     * CAN 2.0, or one of 12, 16, 20, 24, 32, 48 and 64 for CAN FD.
+     */
+    const uint8 txDl;
+
+    /**
+     * @brief maximum number of CFs handed over to CanIf without waiting for their confirmation,
+     * if the receiver requested a STmin of 0 (0 or 1: one CF at a time, at most
+     * CANTP_MAX_TX_WINDOW). a larger window is not supported with a transmission connection pool.
+     */
+    const uint8 txWindow;
+
+    /**
+     * @brief maximum number of transmit requests accepted by @ref CanTp_Transmit while a session
+     * is ongoing on this TxNSdu, each one being started as soon as the previous session ends (0:
+     * such requests are rejected, see SWS_CanTp_00206).
+     */
+    const uint8 txQueueDepth;
+
+    /**
+     * @brief if TRUE, a SF, FF or CF rejected by CanIf_Transmit is transmitted again on the next
+     * calls of CanTp_MainFunction (or @ref CanTp_TxMailboxFree) until N_As expires, instead of
+     * terminating the transmission (see SWS_CanTp_00343).
+     */
+    const boolean transmitRetry;
+
+    /**
+     * @brief if TRUE, the upper layer reports through @ref CanTp_TxDataAvailable that data can be
+     * provided again after PduR_CanTpCopyTxData returned BUFREQ_E_BUSY, and PduR_CanTpCopyTxData
+     * is not polled until then (N_Cs still applies, see SWS_CanTp_00184).
+     */
+    const boolean dataNotification;
+
+    /**
+     * @brief size of the staging buffer in which the payload is requested from the upper layer in
+     * chunks of up to this size, instead of one PduR_CanTpCopyTxData call per frame (0: no staging
+     * buffer, otherwise at least the largest frame payload).
+     */
+    const uint16 txStagingSize;
+
+    /**
+     * @brief if TRUE, N_SA and N_TA are not fixed by the configuration but taken from the CAN_ID_32
+     * meta data given to @ref CanTp_Transmit (N_TA in bits 8 to 15, N_SA in bits 0 to 7), and each
+     * peer is served by its own entry of the connection pool (see @ref CanTp_ConfigType::pPeer).
+     * only supported by the CANTP_NORMALFIXED and CANTP_MIXED29BIT addressing formats, without
+     * staging buffer, transmit queue nor transmit window.
+     */
+    const boolean dynamicAddressing;
+
 } CanTp_TxNSduType; /* CanTpTxNSdu. */
 
 
@@ -278,8 +434,155 @@ typedef struct
         const uint32 txNSduCnt;
     } nSdu;
     const CanTp_ChannelMode channelMode;
+
+    /**
+     * @brief defines if the N-SDUs of this channel are processed from the callbacks or deferred to
+     * the main function (non-standard).
+     */
+    const CanTp_ProcessingModeType processingMode;
 } CanTp_ChannelType; /* CanTpChannel. */
 
+/**
+ * @brief counters of the transmit request queue of a Tx N-SDU, see @ref CanTp_GetTxQueueStatus.
+ */
+typedef struct
+{
+    /**
+     * @brief number of requests accepted into the queue since @ref CanTp_Init.
+     */
+    uint32 enqueued;
+
+    /**
+     * @brief number of requests taken out of the queue to start their session since @ref
+     * CanTp_Init.
+     */
+    uint32 dequeued;
+
+    /**
+     * @brief number of requests rejected because the queue was full since @ref CanTp_Init.
+     */
+    uint32 rejected;
+
+    /**
+     * @brief number of requests currently waiting in the queue.
+     */
+    uint8 pending;
+} CanTp_TxQueueStatusType;
+
+/**
+ * @brief counters of the transmit stalls of a Tx N-SDU (PduR_CanTpCopyTxData returning
+ * BUFREQ_E_BUSY), see @ref CanTp_GetTxStallStatus.
+ */
+typedef struct
+{
+    /**
+     * @brief number of stalls since @ref CanTp_Init, including the ongoing one.
+     */
+    uint32 count;
+
+    /**
+     * @brief cumulated duration of the ended stalls since @ref CanTp_Init [us].
+     */
+    uint32 total_time;
+
+    /**
+     * @brief duration of the longest ended stall since @ref CanTp_Init [us].
+     */
+    uint32 max_time;
+} CanTp_TxStallStatusType;
+
+/**
+ * @brief behavior of the module when a SF or FF is received while all the reception connections of
+ * the pool are in use (see @ref CanTp_ConfigType::pRxConnectionPool).
+ */
+typedef enum
+{
+    /**
+     * @brief the N-PDU is ignored, the sender of a FF eventually aborts its transmission on N_Bs
+     * timeout.
+     */
+    CANTP_POOL_POLICY_REJECT,
+
+    /**
+     * @brief the N-PDU is ignored, and a FF is answered with a FC(OVFLW) so that the sender aborts
+     * its transmission right away.
+     */
+    CANTP_POOL_POLICY_OVERFLOW
+
+} CanTp_PoolPolicyType;
+
+/**
+ * @brief counters of the connection pools, see @ref CanTp_GetConnectionPoolStatus.
+ */
+typedef struct
+{
+    /**
+     * @brief number of reception connections currently bound to an N-SDU.
+     */
+    uint32 rx_in_use;
+
+    /**
+     * @brief largest number of reception connections simultaneously bound since @ref CanTp_Init.
+     */
+    uint32 rx_high_water;
+
+    /**
+     * @brief number of SF and FF ignored because no reception connection was available since @ref
+     * CanTp_Init.
+     */
+    uint32 rx_rejected;
+
+    /**
+     * @brief number of transmission connections currently bound to an N-SDU.
+     */
+    uint32 tx_in_use;
+
+    /**
+     * @brief largest number of transmission connections simultaneously bound since @ref CanTp_Init.
+     */
+    uint32 tx_high_water;
+
+    /**
+     * @brief number of transmit requests rejected because no transmission connection was available
+     * since @ref CanTp_Init.
+     */
+    uint32 tx_rejected;
+} CanTp_ConnectionPoolStatusType;
+
+
+/**
+ * @brief runtime data types: their content is private to the CanTp module (see CanTp_Rt.h), the
+ * post-build configuration only refers to the storage allocated by the generated source.
+ */
+typedef struct CanTp_RxConnection CanTp_RxConnectionType;
+typedef struct CanTp_TxConnection CanTp_TxConnectionType;
+typedef struct CanTp_Peer CanTp_PeerType;
+typedef struct CanTp_Timer CanTp_TimerType;
+typedef struct CanTp_ChannelRt CanTp_ChannelRtType;
+
+
+/**
+ * @brief entry of the table mapping an N-SDU identifier (used as index) to its runtime location.
+ */
+typedef struct
+{
+    /**
+     * @brief index of the channel owning the N-SDU.
+     */
+    const uint16 channel;
+
+    /**
+     * @brief index of the N-SDU runtime slot within the channel.
+     */
+    const uint16 nSdu;
+
+    /**
+     * @brief combination of CANTP_DIRECTION_RX and CANTP_DIRECTION_TX, or 0x00u if the identifier
+     * is not configured.
+     */
+    const uint8 direction;
+} CanTp_PduIdMapType;
+
 
 /**
  * @brief data structure type for the post-build configuration parameters.
@@ -294,6 +597,76 @@ typedef struct
     const uint32 maxChannelCnt; /* CanTpMaxChannelCnt. */
     const CanTp_ChannelType *pChannel;
     const uint8 paddingByte; /* CanTpPaddingByte. */
+
+    /**
+     * @brief table indexed by N-SDU identifier (relatively to pduIdMapBase), giving the channel and
+     * slot of each N-SDU.
+     */
+    const CanTp_PduIdMapType *pPduIdMap;
+
+    /**
+     * @brief number of entries of the table pointed by pPduIdMap.
+     */
+    const PduIdType pduIdMapSize;
+
+    /**
+     * @brief N-SDU identifier of the first entry of the table pointed by pPduIdMap, i.e. the lowest
+     * identifier of the configuration, so that the identifiers below it do not take any room.
+     */
+    const PduIdType pduIdMapBase;
+
+    /**
+     * @brief runtime storage of each channel (same order as pChannel).
+     */
+    const CanTp_ChannelRtType *pChannelRt;
+
+    /**
+     * @brief storage of the timer heap, large enough to hold all timers of all N-SDUs.
+     */
+    CanTp_TimerType *pTimerHeap;
+
+    /**
+     * @brief number of entries of the array pointed by pTimerHeap.
+     */
+    const uint32 timerHeapSize;
+
+    /**
+     * @brief connection pool shared by the dynamically addressed N-SDUs, NULL_PTR if none is
+     * configured.
+     */
+    CanTp_PeerType *pPeer;
+
+    /**
+     * @brief number of entries of the array pointed by pPeer.
+     */
+    const uint32 peerCnt;
+
+    /**
+     * @brief reception connections bound to the Rx N-SDUs on reception of a SF or FF and given back
+     * at the end of the session, NULL_PTR if each Rx N-SDU owns a dedicated connection.
+     */
+    CanTp_RxConnectionType *pRxConnectionPool;
+
+    /**
+     * @brief number of entries of the array pointed by pRxConnectionPool.
+     */
+    const uint32 rxConnectionPoolSize;
+
+    /**
+     * @brief transmission connections bound to the Tx N-SDUs on transmit request and given back at
+     * the end of the session, NULL_PTR if each Tx N-SDU owns a dedicated connection.
+     */
+    CanTp_TxConnectionType *pTxConnectionPool;
+
+    /**
+     * @brief number of entries of the array pointed by pTxConnectionPool.
+     */
+    const uint32 txConnectionPoolSize;
+
+    /**
+     * @brief behavior on reception of a SF or FF while the reception connection pool is exhausted.
+     */
+    const CanTp_PoolPolicyType poolPolicy;
 } CanTp_ConfigType;
 
 /** @} */
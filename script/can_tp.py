@@ -15,15 +15,91 @@ class CodeGen(object):
     def config(self):
         return self._config
 
+    @staticmethod
+    def _map_configuration(configuration):
+        """
+        returns the mapping of the N-SDUs of a configuration to their runtime storage, as a dictionary giving the
+        (channel, slot, directions) tuple of each PduId and the number of slots of each channel. the Rx and Tx N-SDUs of
+        a channel sharing the same identifier are mapped to the same slot, and slots are allocated contiguously within
+        each channel.
+        """
+        entries = dict()
+        slot_counts = list()
+        for channel_idx, channel in enumerate(configuration.get('channels', ())):
+            slots = dict()
+            for key, direction in (('receivers', 'CANTP_DIRECTION_RX'), ('transmitters', 'CANTP_DIRECTION_TX')):
+                for n_sdu in channel.get(key, ()):
+                    pdu_id = n_sdu['network_service_data_unit_identifier']
+                    if pdu_id in entries and entries[pdu_id][0] != channel_idx:
+                        raise ValueError('PduId {} is used by several channels'.format(pdu_id))
+                    if direction in entries.get(pdu_id, (None, None, ()))[2]:
+                        raise ValueError('PduId {} is used by several {}'.format(pdu_id, key))
+                    slot = slots.setdefault(pdu_id, len(slots))
+                    entries.setdefault(pdu_id, (channel_idx, slot, []))[2].append(direction)
+            slot_counts.append(len(slots))
+        return entries, slot_counts
+
+    @property
+    def pdu_id_maps(self):
+        """
+        for each configuration, returns a list indexed by PduId (relatively to the lowest PduId of the configuration, see
+        pdu_id_map_bases) holding the (channel, slot, direction) tuple of the corresponding N-SDU, or None if the PduId
+        is not configured.
+        """
+        maps = list()
+        for configuration, base in zip(self.config.get('configurations', ()), self.pdu_id_map_bases):
+            entries, _ = self._map_configuration(configuration)
+            maps.append([entries.get(pdu_id) for pdu_id in range(base, max(entries) + 1 if entries else 0)])
+        return maps
+
+    @property
+    def pdu_id_map_bases(self):
+        """
+        for each configuration, returns the lowest PduId of its N-SDUs (0 if it has none), i.e. the PduId of the first
+        entry of its PduId map.
+        """
+        return [min(self._map_configuration(configuration)[0] or (0,))
+                for configuration in self.config.get('configurations', ())]
+
+    @property
+    def n_sdu_counts(self):
+        """
+        for each configuration, returns the number of N-SDU runtime slots of each channel.
+        """
+        return [self._map_configuration(configuration)[1] for configuration in self.config.get('configurations', ())]
+
+    @property
+    def constants(self):
+        """
+        returns the parameters shared by all the N-SDUs of the configuration, None for each parameter whose value
+        differs between N-SDUs. these values are only meaningful if a single configuration is generated: they are used by
+        the pre-compile variant to let the compiler remove the code handling the unused values.
+        """
+        paddings = set()
+        n_ai_sizes = set()
+        for configuration in self.config.get('configurations', ()):
+            for channel in configuration.get('channels', ()):
+                for n_sdu in list(channel.get('receivers', ())) + list(channel.get('transmitters', ())):
+                    paddings.add('CANTP_ON' if n_sdu.get('enable_padding') else 'CANTP_OFF')
+                    if n_sdu['addressing_format'] in ('CANTP_STANDARD', 'CANTP_NORMALFIXED'):
+                        n_ai_sizes.add('0x00u')
+                    else:
+                        n_ai_sizes.add('0x01u')
+        return dict(padding=paddings.pop() if len(paddings) == 1 else None,
+                    n_ai_size=n_ai_sizes.pop() if len(n_ai_sizes) == 1 else None)
+
     @property
     def source(self):
         template = self.environment.get_template('config.c.jinja2')
-        return template.render(**self.config)
+        return template.render(pdu_id_maps=self.pdu_id_maps,
+                               pdu_id_map_bases=self.pdu_id_map_bases,
+                               n_sdu_counts=self.n_sdu_counts,
+                               **self.config)
 
     @property
     def header(self):
         template = self.environment.get_template('config.h.jinja2')
-        return template.render(**self.config)
+        return template.render(constants=self.constants, **self.config)
 
 
 def main():
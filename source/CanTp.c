@@ -56,6 +56,8 @@ extern "C"
 
 #include "CanTp_Cfg.h"
 
+#include "CanTp_Rt.h"
+
 #ifndef CANTP_CBK_H
 #include "CanTp_Cbk.h"
 #endif /* #ifndef CANTP_CBK_H */
@@ -76,6 +78,14 @@ extern "C"
 
 #endif /* #if (CANTP_DEV_ERROR_DETECT == STD_ON) */
 
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON)
+
+/* pre-compile variant: the generated configuration is compiled with the module, so that its
+ * parameters are constants known to the compiler. */
+#include "CanTp_PBcfg.c"
+
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) */
+
 /** @} */
 
 
@@ -107,15 +117,19 @@ extern "C"
 
 #define CANTP_SF_PCI_FIELD_SIZE (0x01u)
 
+#define CANTP_SF_ESC_PCI_FIELD_SIZE (0x02u)
+
 #define CANTP_FF_PCI_FIELD_SIZE (0x02u)
 
+#define CANTP_FF_ESC_PCI_FIELD_SIZE (0x06u)
+
+#define CANTP_FF_DL_12BIT_MAX (0x0FFFu)
+
 #define CANTP_CF_PCI_FIELD_SIZE (0x01u)
 
 #define CANTP_BS_INFINITE (0x0100u)
 
-#define CANTP_DIRECTION_RX (0x01u)
-
-#define CANTP_DIRECTION_TX (0x02u)
+#define CANTP_FRAME_STATE_CNT ((uint8)CANTP_FRAME_STATE_ABORT + 0x01u)
 
 /** @} */
 
@@ -131,96 +145,31 @@ extern "C"
 
 typedef uint8 CanTp_NPciType;
 
-typedef uint8 CanTp_FlowStatusType;
-
-typedef enum {
-    CANTP_FRAME_STATE_INVALID = 0x00u,
-    CANTP_RX_FRAME_STATE_FC_TX_REQUEST,
-    CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION,
-    CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION,
-    CANTP_RX_FRAME_STATE_CF_RX_INDICATION,
-    CANTP_TX_FRAME_STATE_SF_TX_REQUEST,
-    CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION,
-    CANTP_TX_FRAME_STATE_FF_TX_REQUEST,
-    CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION,
-    CANTP_TX_FRAME_STATE_CF_TX_REQUEST,
-    CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION,
-    CANTP_TX_FRAME_STATE_FC_RX_INDICATION,
-    CANTP_FRAME_STATE_OK,
-    CANTP_FRAME_STATE_ABORT
-} CanTp_FrameStateType;
-
-typedef enum
-{
-    CANTP_WAIT = 0x00u,
-    CANTP_PROCESSING
-} CanTp_TaskStateType;
-
-typedef struct
-{
-    uint8 can[CANTP_CAN_FRAME_SIZE];
-    PduLengthType size;
-    PduLengthType rmng;
-} CanTp_NSduBufferType;
-
-typedef struct
-{
-    const CanTp_RxNSduType *cfg;
-    CanTp_NSduBufferType buf;
-    CanTp_FlowStatusType fs;
-    uint32 st_min;
-    uint8 bs;
-    uint8 sn;
-    uint16 wft_max;
-    PduInfoType can_if_pdu_info;
-    PduInfoType pdu_r_pdu_info;
-    struct
-    {
-        CanTp_TaskStateType taskState;
-        CanTp_FrameStateType state;
-
-        /**
-         * @brief structure containing all parameters accessible via @ref CanTp_ReadParameter/@ref
-         * CanTp_ChangeParameter.
-         */
-        struct {
-            uint32 st_min;
-            uint8 bs;
-        } m_param;
-    } shared;
-} CanTp_RxConnectionType;
-
+/**
+ * @brief handlers of one state of the Rx or Tx state machine of an N-SDU, one for each event. a
+ * NULL_PTR handler means that the event is ignored in this state.
+ */
 typedef struct
 {
-    const CanTp_TxNSduType *cfg;
-    CanTp_NSduBufferType buf;
-    CanTp_FlowStatusType fs;
-    uint32 target_st_min;
-    uint32 st_min;
-    uint16 bs;
-    uint8 sn;
-    PduInfoType can_if_pdu_info;
-    CanTp_TaskStateType taskState;
-    struct
-    {
-        CanTp_FrameStateType state;
-        uint32 flag;
-    } shared;
-} CanTp_TxConnectionType;
+    /**
+     * @brief called by the main function for each active N-SDU in this state.
+     */
+    void (*mainFunction)(CanTp_NSduType *pNSdu);
 
-typedef struct
-{
-    CanTp_RxConnectionType rx;
-    CanTp_TxConnectionType tx;
-    uint32 n[0x06u];
-    uint8_least dir;
-    uint32 t_flag;
-} CanTp_NSduType;
+    /**
+     * @brief called by CanTp_TxConfirmation for an N-PDU sent in this state, returns the next state.
+     */
+    CanTp_FrameStateType (*confirmation)(CanTp_NSduType *pNSdu);
 
-typedef struct
-{
-    CanTp_NSduType sdu[CANTP_MAX_NUM_OF_N_SDU];
-} CanTp_ChannelRtType;
+    /**
+     * @brief called by CanTp_RxIndication for an N-PDU of type pci received in this state, returns
+     * the next state.
+     */
+    CanTp_FrameStateType (*indication)(CanTp_NSduType *pNSdu,
+                                       const PduInfoType *pPduInfo,
+                                       const PduLengthType nAeSize);
+    CanTp_NPciType pci;
+} CanTp_StateHandlerType;
 
 /** @} */
 
@@ -246,6 +195,24 @@ typedef struct
 
 #endif /* #ifndef CANTP_EXIT_CRITICAL_SECTION */
 
+/* hook called each time an event is dispatched to a state of the Rx (direction is
+ * CANTP_DIRECTION_RX) or Tx state machine of an N-SDU, e.g. to count the dispatches per state. */
+#ifndef CANTP_STATE_HANDLER_HOOK
+
+#define CANTP_STATE_HANDLER_HOOK(direction, state)
+
+#endif /* #ifndef CANTP_STATE_HANDLER_HOOK */
+
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON)
+
+#define CANTP_CONFIG_PTR (&CanTp_Config[0x00u])
+
+#else
+
+#define CANTP_CONFIG_PTR (CanTp_ConfigPtr)
+
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) */
+
 LOCAL_INLINE uint32 CanTp_ConvertMsToUs(uint32 timeout)
 {
     return timeout * 1000u;
@@ -286,6 +253,76 @@ LOCAL_INLINE void CanTp_ReportRuntimeError(uint8 instanceId, uint8 apiId, uint8
 #endif /* #if (CANTP_DEV_ERROR_DETECT == STD_ON) */
 }
 
+LOCAL_INLINE CanTp_StateType CanTp_GetPaddingActivation(const CanTp_StateType padding)
+{
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON) && defined(CANTP_CFG_PADDING_ACTIVATION)
+
+    /* all the N-SDUs share the same padding activation, the unused padding code is removed. */
+    (void)padding;
+
+    return CANTP_CFG_PADDING_ACTIVATION;
+
+#else
+
+    return padding;
+
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) && defined(CANTP_CFG_PADDING_ACTIVATION) */
+}
+
+LOCAL_INLINE uint8 CanTp_GetNAiSize(const CanTp_FrameGeometryType *pGeometry)
+{
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON) && defined(CANTP_CFG_N_AI_SIZE)
+
+    /* all the N-SDUs use addressing formats with the same N_AI size, the offsets are folded. */
+    (void)pGeometry;
+
+    return CANTP_CFG_N_AI_SIZE;
+
+#else
+
+    return pGeometry->n_ai_size;
+
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) && defined(CANTP_CFG_N_AI_SIZE) */
+}
+
+LOCAL_INLINE boolean CanTp_DeadlineBefore(const uint32 deadline, const uint32 reference)
+{
+    boolean result = FALSE;
+
+    /* deadlines are compared relatively to each other, so that the time base can wrap around. */
+    if ((uint32)(deadline - reference) >= 0x80000000u)
+    {
+        result = TRUE;
+    }
+
+    return result;
+}
+
+LOCAL_INLINE uint8 *CanTp_GetRxMetaData(const CanTp_NSduType *pNSdu)
+{
+    uint8 *p_meta_data = NULL_PTR;
+
+    /* only the connection pool entries carry a meta data item. */
+    if (pNSdu->p_peer != NULL_PTR)
+    {
+        p_meta_data = &pNSdu->p_peer->rx_meta[0x00u];
+    }
+
+    return p_meta_data;
+}
+
+LOCAL_INLINE uint8 *CanTp_GetTxMetaData(const CanTp_NSduType *pNSdu)
+{
+    uint8 *p_meta_data = NULL_PTR;
+
+    if (pNSdu->p_peer != NULL_PTR)
+    {
+        p_meta_data = &pNSdu->p_peer->tx_meta[0x00u];
+    }
+
+    return p_meta_data;
+}
+
 /** @} */
 
 
@@ -306,6 +343,38 @@ static Std_ReturnType CanTp_GetNSduFromPduId(PduIdType pduId, CanTp_NSduType **p
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
+#define CanTp_START_SEC_CODE_SLOW
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function fills a memory area with zeros.
+ *
+ * @param pMemory [out]: memory area to clear, may be NULL_PTR if size is 0
+ * @param size [in]: size of the memory area in bytes
+ */
+static void CanTp_ClearMemory(void *pMemory, uint32 size);
+
+#define CanTp_STOP_SEC_CODE_SLOW
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_SLOW
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function returns the PduId map entry of an N-SDU configured in a given channel.
+ *
+ * @param pConfig [in]: post-build configuration
+ * @param pduId [in]: N-SDU identifier
+ * @param channelIdx [in]: index of the channel in which the N-SDU is configured
+ * @return pointer to the map entry, NULL_PTR if the entry is missing or inconsistent
+ */
+static const CanTp_PduIdMapType *CanTp_GetPduIdMapEntry(const CanTp_ConfigType *pConfig,
+                                                        PduIdType pduId,
+                                                        uint32_least channelIdx);
+
+#define CanTp_STOP_SEC_CODE_SLOW
+#include "CanTp_MemMap.h"
+
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
@@ -314,23 +383,45 @@ static PduLengthType CanTp_GetRxBlockSize(const CanTp_NSduType *pNSdu);
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-#define CanTp_START_SEC_CODE_FAST
+#define CanTp_START_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
-static Std_ReturnType CanTp_DecodeNAIValue(const CanTp_AddressingFormatType af,
-                                           PduLengthType *pPduLength);
+/**
+ * @brief this function computes the frame geometry of a connection from its addressing format and
+ * its data link layer data length (the SF_DL escape sequence is used if the DL is > 8).
+ *
+ * @param pGeometry [out]: frame geometry of the connection
+ * @param af [in]: addressing format of the N-SDU
+ * @param pNAe [in]: N_AE value of the N-SDU, may be NULL_PTR
+ * @param pNTa [in]: N_TA value of the N-SDU, may be NULL_PTR
+ * @param dl [in]: data link layer data length (RX_DL or TX_DL) of the N-SDU
+ */
+static void CanTp_InitFrameGeometry(CanTp_FrameGeometryType *pGeometry,
+                                    const CanTp_AddressingFormatType af,
+                                    const CanTp_NAeType *pNAe,
+                                    const CanTp_NTaType *pNTa,
+                                    const uint8 dl);
 
-#define CanTp_STOP_SEC_CODE_FAST
+#define CanTp_STOP_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static Std_ReturnType CanTp_EncodeNAIValue(const CanTp_AddressingFormatType af,
-                                           const CanTp_NAeType *pNAe,
-                                           const CanTp_NTaType *pNTa,
-                                           uint8 *pBuffer,
-                                           PduLengthType *pOfs);
+/**
+ * @brief this function starts a new transmission session on a Tx N-SDU.
+ *
+ * @param txPduId [in]: identifier of the PDU to be transmitted
+ * @param pPduInfo [in]: length of the PDU
+ * @param pData [in]: payload of the PDU if provided by the caller, NULL_PTR if the payload is
+ * requested through PduR_CanTpCopyTxData
+ * @param serviceId [in]: API ID of the calling service, used to report errors
+ * @return E_OK if the transmit request has been accepted, E_NOT_OK otherwise
+ */
+static Std_ReturnType CanTp_StartTransmission(PduIdType txPduId,
+                                              const PduInfoType *pPduInfo,
+                                              const uint8 *pData,
+                                              const uint8 serviceId);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -339,15 +430,19 @@ static Std_ReturnType CanTp_EncodeNAIValue(const CanTp_AddressingFormatType af,
 #include "CanTp_MemMap.h"
 
 /**
- * @brief this function decodes a raw minimum separation time (STmin) to a value in microsecond(s),
- * according to ISO 15765-2.
- *
- * @note see section 6.5.5.5 of ISO 15765-2.
+ * @brief this function determines the first frame (SF or FF) of a transmission of the given
+ * length on a Tx N-SDU.
  *
- * @param data [in]: the raw minimum separation time (8 bits STmin value)
- * @return decoded minimum separation time value [us]
+ * @param pNSdu [in]: the N-SDU to transmit
+ * @param length [in]: length of the PDU
+ * @param serviceId [in]: API ID of the calling service, used to report errors
+ * @param pState [out]: the initial state of the transmission
+ * @return E_OK if the transmission can be performed, E_NOT_OK otherwise
  */
-static uint32 CanTp_DecodeSTMinValue(const uint8 data);
+static Std_ReturnType CanTp_GetTxStartState(const CanTp_NSduType *pNSdu,
+                                            const PduLengthType length,
+                                            const uint8 serviceId,
+                                            CanTp_FrameStateType *pState);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -356,15 +451,12 @@ static uint32 CanTp_DecodeSTMinValue(const uint8 data);
 #include "CanTp_MemMap.h"
 
 /**
- * @brief this function encodes a minimum separation time in microsecond(s) (STmin) to a 8 bits
- * value, according to ISO 15765-2.
- *
- * @note see section 6.5.5.5 of ISO 15765-2.
+ * @brief this function initializes the transmission connection of a Tx N-SDU for a new session.
  *
- * @param value [in]: the minimum separation time [us]
- * @return encoded minimum separation time value (8 bits STmin value)
+ * @param pNSdu [in]: the N-SDU to transmit
+ * @param pRequest [in]: the transmit request starting the session
  */
-static uint8 CanTp_EncodeSTMinValue(const uint32 value);
+static void CanTp_BeginTxSession(CanTp_NSduType *pNSdu, const CanTp_TxRequestType *pRequest);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -372,7 +464,13 @@ static uint8 CanTp_EncodeSTMinValue(const uint32 value);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static Std_ReturnType CanTp_DecodePCIValue(CanTp_NPciType *pPci, const uint8 *pData);
+/**
+ * @brief this function ends the ongoing transmit stall of a Tx N-SDU, if any, and accounts for
+ * its duration in the stall counters.
+ *
+ * @param pNSdu [in]: the N-SDU to update
+ */
+static void CanTp_EndTxStall(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -380,9 +478,16 @@ static Std_ReturnType CanTp_DecodePCIValue(CanTp_NPciType *pPci, const uint8 *pD
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static PduLengthType CanTp_DecodeDLValue(const CanTp_NPciType frameType,
-                                         const CanTp_RxPaddingActivationType padding,
-                                         const uint8 *pData);
+/**
+ * @brief this function appends a transmit request to the queue of a Tx N-SDU on which a session
+ * is ongoing.
+ *
+ * @param pNSdu [in]: the N-SDU to transmit
+ * @param pRequest [in]: the transmit request to append
+ * @return E_OK if the request has been queued, E_NOT_OK if the queue is full
+ */
+static Std_ReturnType CanTp_EnqueueTxRequest(CanTp_NSduType *pNSdu,
+                                             const CanTp_TxRequestType *pRequest);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -390,7 +495,14 @@ static PduLengthType CanTp_DecodeDLValue(const CanTp_NPciType frameType,
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static void CanTp_AbortRxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolean confirm);
+/**
+ * @brief this function starts the session of the oldest queued transmit request of a Tx N-SDU,
+ * provided that no session is ongoing on it.
+ *
+ * @param pNSdu [in]: the N-SDU to transmit
+ * @return TRUE if a new session has been started, FALSE otherwise
+ */
+static boolean CanTp_StartNextTxRequest(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -398,7 +510,13 @@ static void CanTp_AbortRxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolea
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static void CanTp_AbortTxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolean confirm);
+/**
+ * @brief this function transmits again the FC of a Rx N-SDU previously rejected by CanIf. N_Ar,
+ * started by the first attempt, keeps running.
+ *
+ * @param pNSdu [in]: the N-SDU being received
+ */
+static void CanTp_RetryRxCANData(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -406,7 +524,13 @@ static void CanTp_AbortTxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolea
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function transmits again the N-PDU of a Tx N-SDU previously rejected by CanIf. N_As,
+ * started by the first attempt, keeps running.
+ *
+ * @param pNSdu [in]: the N-SDU being transmitted
+ */
+static void CanTp_RetryTxCANData(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -414,31 +538,52 @@ static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static void CanTp_PerformStepTx(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function hands the bytes accumulated in the staging buffer over to the upper layer by
+ * calling PduR_CanTpCopyRxData. it does nothing if the staging buffer is empty.
+ *
+ * @param pNSdu [in]: the N-SDU being received
+ * @return result of PduR_CanTpCopyRxData, BUFREQ_OK if nothing has to be notified
+ */
+static BufReq_ReturnType CanTp_FlushRxPayload(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-#define CanTp_START_SEC_CODE_FAST
+#define CanTp_START_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
-static BufReq_ReturnType CanTp_CopyRxPayload(CanTp_NSduType *pNSdu);
+static Std_ReturnType CanTp_DecodeNAIValue(const CanTp_AddressingFormatType af,
+                                           PduLengthType *pPduLength);
 
-#define CanTp_STOP_SEC_CODE_FAST
+#define CanTp_STOP_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
-#define CanTp_START_SEC_CODE_FAST
+#define CanTp_START_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
-static BufReq_ReturnType CanTp_CopyTxPayload(CanTp_NSduType *pNSdu, PduLengthType *pOfs);
+static Std_ReturnType CanTp_EncodeNAIValue(const CanTp_AddressingFormatType af,
+                                           const CanTp_NAeType *pNAe,
+                                           const CanTp_NTaType *pNTa,
+                                           uint8 *pBuffer,
+                                           PduLengthType *pOfs);
 
-#define CanTp_STOP_SEC_CODE_FAST
+#define CanTp_STOP_SEC_CODE_SLOW
 #include "CanTp_MemMap.h"
 
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static void CanTp_SetPadding(uint8 *pBuffer, PduLengthType *pOfs, const uint8 value);
+/**
+ * @brief this function decodes a raw minimum separation time (STmin) to a value in microsecond(s),
+ * according to ISO 15765-2.
+ *
+ * @note see section 6.5.5.5 of ISO 15765-2.
+ *
+ * @param data [in]: the raw minimum separation time (8 bits STmin value)
+ * @return decoded minimum separation time value [us]
+ */
+static uint32 CanTp_DecodeSTMinValue(const uint8 data);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -446,7 +591,16 @@ static void CanTp_SetPadding(uint8 *pBuffer, PduLengthType *pOfs, const uint8 va
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataReqTSF(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function encodes a minimum separation time in microsecond(s) (STmin) to a 8 bits
+ * value, according to ISO 15765-2.
+ *
+ * @note see section 6.5.5.5 of ISO 15765-2.
+ *
+ * @param value [in]: the minimum separation time [us]
+ * @return encoded minimum separation time value (8 bits STmin value)
+ */
+static uint8 CanTp_EncodeSTMinValue(const uint32 value);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -454,7 +608,7 @@ static CanTp_FrameStateType CanTp_LDataReqTSF(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataReqTFF(CanTp_NSduType *pNSdu);
+static Std_ReturnType CanTp_DecodePCIValue(CanTp_NPciType *pPci, const uint8 *pData);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -462,7 +616,9 @@ static CanTp_FrameStateType CanTp_LDataReqTFF(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataReqTCF(CanTp_NSduType *pNSdu);
+static PduLengthType CanTp_DecodeDLValue(const CanTp_NPciType frameType,
+                                         const CanTp_RxPaddingActivationType padding,
+                                         const uint8 *pData);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -470,7 +626,22 @@ static CanTp_FrameStateType CanTp_LDataReqTCF(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataReqRFC(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function checks the data length of a received SF or FF according to ISO 15765-2: a SF
+ * longer than a CAN 2.0 frame must be encoded with the SF_DL escape sequence, the data length of a
+ * SF fitting in a CAN 2.0 frame is always accepted. a FF must hold its whole N_PCI, and its FF_DL
+ * must neither fit in a SF nor be encoded with the escape sequence below 4096 bytes.
+ *
+ * @param pNSdu [in]: the N-SDU receiving the frame
+ * @param pPduInfo [in]: the received N-PDU
+ * @param nAeSize [in]: size of the N_AE field of the N-PDU
+ * @param pci [in]: N_PCI type of the N-PDU
+ * @return E_OK if the frame is processed, E_NOT_OK if it shall be ignored
+ */
+static Std_ReturnType CanTp_CheckRxDLValue(const CanTp_NSduType *pNSdu,
+                                           const PduInfoType *pPduInfo,
+                                           const PduLengthType nAeSize,
+                                           const CanTp_NPciType pci);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -478,8 +649,7 @@ static CanTp_FrameStateType CanTp_LDataReqRFC(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType
-CanTp_LDataIndRSF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+static void CanTp_AbortRxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolean confirm);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -487,8 +657,7 @@ CanTp_LDataIndRSF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduL
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType
-CanTp_LDataIndRFF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+static void CanTp_AbortTxSession(CanTp_NSduType *pNSdu, uint8 instanceId, boolean confirm);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -496,8 +665,7 @@ CanTp_LDataIndRFF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduL
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType
-CanTp_LDataIndRCF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -505,8 +673,13 @@ CanTp_LDataIndRCF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduL
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType
-CanTp_LDataIndTFC(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+/**
+ * @brief this function processes a pending flow control transmission request: the FC N-PDU is
+ * encoded and handed over to the lower layer if it can be sent.
+ *
+ * @param pNSdu [in]: the N-SDU on which the flow control is requested
+ */
+static void CanTp_PerformStepRxFC(CanTp_NSduType *pNSdu);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -514,7 +687,19 @@ CanTp_LDataIndTFC(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduL
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataConRFC(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function hands an N-PDU over to CanIf. if the N-SDU is a connection pool entry, the
+ * N-PDU is recorded as pending, so that its confirmation can be routed back to this entry, or
+ * deferred if another entry bound to the same N-SDU has unconfirmed N-PDUs.
+ *
+ * @param pNSdu [in]: the N-SDU transmitting the N-PDU
+ * @param txPduId [in]: identifier of the N-PDU
+ * @param pPduInfo [in]: the N-PDU to transmit
+ * @return the result of CanIf_Transmit, E_NOT_OK if the N-PDU is deferred
+ */
+static Std_ReturnType CanTp_TransmitNPdu(CanTp_NSduType *pNSdu,
+                                         PduIdType txPduId,
+                                         const PduInfoType *pPduInfo);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -522,7 +707,21 @@ static CanTp_FrameStateType CanTp_LDataConRFC(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataConTSF(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function looks up the connection pool entry serving the peer identified by a CAN_ID_32
+ * meta data item on a dynamically addressed N-SDU, and binds a free entry to this peer if none is
+ * found.
+ *
+ * @param pNSdu [in/out]: the dynamically addressed N-SDU, replaced by the N-SDU of the entry
+ * @param pMetaData [in]: the meta data item, may be NULL_PTR
+ * @param received [in]: TRUE if the meta data item is the CAN identifier of a received N-PDU, FALSE
+ * if it is the CAN identifier of the N-PDUs to transmit
+ * @retval E_OK an entry is bound to the peer
+ * @retval E_NOT_OK no meta data item is given or the connection pool is exhausted
+ */
+static Std_ReturnType CanTp_BindPeer(CanTp_NSduType **pNSdu,
+                                     const uint8 *pMetaData,
+                                     const boolean received);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -530,7 +729,14 @@ static CanTp_FrameStateType CanTp_LDataConTSF(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataConTFF(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function initializes a connection for the given configuration: all runtime data are
+ * cleared and the frame geometry is computed.
+ *
+ * @param pConnection [out]: the reception connection to initialize
+ * @param pCfg [in]: configuration of the Rx N-SDU, may be NULL_PTR for an unused connection
+ */
+static void CanTp_InitRxConnection(CanTp_RxConnectionType *pConnection, const CanTp_RxNSduType *pCfg);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
@@ -538,685 +744,2656 @@ static CanTp_FrameStateType CanTp_LDataConTFF(CanTp_NSduType *pNSdu);
 #define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_FrameStateType CanTp_LDataConTCF(CanTp_NSduType *pNSdu);
+/**
+ * @brief this function initializes a connection for the given configuration: all runtime data are
+ * cleared and the frame geometry is computed.
+ *
+ * @param pConnection [out]: the transmission connection to initialize
+ * @param pCfg [in]: configuration of the Tx N-SDU, may be NULL_PTR for an unused connection
+ */
+static void CanTp_InitTxConnection(CanTp_TxConnectionType *pConnection, const CanTp_TxNSduType *pCfg);
 
 #define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-/** @} */
-
-
-/*-----------------------------------------------------------------------------------------------*/
-/* local constant definitions (static const).                                                    */
-/*-----------------------------------------------------------------------------------------------*/
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
 
 /**
- * @addtogroup CANTP_C_LCDEF
- * @{
+ * @brief this function binds a free connection of the reception connection pool to an Rx N-SDU on
+ * reception of a SF or FF. if the pool is exhausted, the N-PDU is rejected according to the pool
+ * policy. it does nothing if a connection is already bound to the N-SDU.
+ *
+ * @param pNSdu [in]: the Rx N-SDU
+ * @param pPduInfo [in]: the received N-PDU
+ * @retval E_OK a connection is bound to the N-SDU
+ * @retval E_NOT_OK the N-PDU does not start a reception or the pool is exhausted
  */
+static Std_ReturnType CanTp_BindRxConnection(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo);
 
-#define CanTp_START_SEC_VAR_FAST_INIT_UNSPECIFIED
+#define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static const CanTp_ConfigType *CanTp_ConfigPtr = NULL_PTR;
-
-#define CanTp_STOP_SEC_VAR_FAST_INIT_UNSPECIFIED
+#define CanTp_START_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-/** @} */
+/**
+ * @brief this function binds a free connection of the transmission connection pool to a Tx N-SDU
+ * on transmit request. it does nothing if a connection is already bound to the N-SDU.
+ *
+ * @param pNSdu [in]: the Tx N-SDU
+ * @retval E_OK a connection is bound to the N-SDU
+ * @retval E_NOT_OK the pool is exhausted
+ */
+static Std_ReturnType CanTp_BindTxConnection(CanTp_NSduType *pNSdu);
 
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
 
-/*-----------------------------------------------------------------------------------------------*/
-/* local variable definitions (static).                                                          */
-/*-----------------------------------------------------------------------------------------------*/
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
 
 /**
- * @addtogroup CANTP_C_LVDEF
- * @{
+ * @brief this function answers a FF received while the reception connection pool is exhausted with
+ * a FC(OVFLW), built on a connection reserved for that purpose.
+ *
+ * @param pNSdu [in]: the Rx N-SDU without connection
  */
+static void CanTp_TransmitOverflowFC(CanTp_NSduType *pNSdu);
 
-#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#define CanTp_STOP_SEC_CODE_FAST
 #include "CanTp_MemMap.h"
 
-static CanTp_ChannelRtType CanTp_Rt[CANTP_MAX_NUM_OF_CHANNEL];
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function gives back the resources bound to an N-SDU once neither a reception nor a
+ * transmission is ongoing on it anymore: the connection pool entry owning a dynamically addressed
+ * N-SDU, or the connections allocated from the connection pools. it does nothing for the N-SDUs
+ * owning dedicated connections.
+ *
+ * @param pNSdu [in]: the N-SDU to release
+ */
+static void CanTp_ReleaseNSdu(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function returns the N-SDU to which the confirmation of an N-PDU is addressed: for a
+ * dynamically addressed N-SDU, the bound connection pool entry having unconfirmed N-PDUs.
+ *
+ * @param pNSdu [in]: the N-SDU identified by the confirmation
+ * @return the confirmed N-SDU
+ */
+static CanTp_NSduType *CanTp_GetConfirmedNSdu(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function returns the N-SDU to which a service called with the identifier of a
+ * dynamically addressed N-SDU applies: the bound connection pool entry having a session in the
+ * given direction. the N-SDU is left unchanged if it is not dynamically addressed or if no entry has
+ * one.
+ *
+ * @param pNSdu [in/out]: the N-SDU identified by the service, replaced by the N-SDU of the entry
+ * @param direction [in]: CANTP_DIRECTION_RX or CANTP_DIRECTION_TX
+ * @retval E_OK the N-SDU is identified
+ * @retval E_NOT_OK several entries have a session in this direction
+ */
+static Std_ReturnType CanTp_GetSessionNSdu(CanTp_NSduType **pNSdu, const uint8 direction);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function inserts an N-SDU in the list of active N-SDUs, if not already present.
+ *
+ * @param pNSdu [in]: the N-SDU on which a reception or a transmission has been started
+ */
+static void CanTp_ActivateNSdu(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function removes an N-SDU from the list of active N-SDUs if neither a reception nor
+ * a transmission is ongoing on it anymore.
+ *
+ * @param pNSdu [in]: the N-SDU to remove
+ */
+static void CanTp_DeactivateNSdu(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function returns the timeout value of a timer of an N-SDU.
+ *
+ * @param pNSdu [in]: the N-SDU owning the timer
+ * @param instanceId [in]: the timer identifier (CANTP_I_N_AS ... CANTP_I_ST_MIN)
+ * @return timeout value [us]
+ */
+static uint32 CanTp_GetTimeout(const CanTp_NSduType *pNSdu, const uint8 instanceId);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function moves a timer of the heap towards the root until its parent deadline is
+ * not later than its own one.
+ *
+ * @param idx [in]: position of the timer in @ref CanTp_TimerHeap
+ */
+static void CanTp_SiftTimerUp(uint32_least idx);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function moves a timer of the heap towards the leaves until none of its children
+ * deadline is earlier than its own one.
+ *
+ * @param idx [in]: position of the timer in @ref CanTp_TimerHeap
+ */
+static void CanTp_SiftTimerDown(uint32_least idx);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function removes the timer located at the given position from the heap.
+ *
+ * @param idx [in]: position of the timer in @ref CanTp_TimerHeap
+ */
+static void CanTp_RemoveTimer(uint32_least idx);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function advances the time base of the module and flags all timers whose deadline
+ * has been reached as expired.
+ *
+ * @param elapsed [in]: time elapsed since the last update [us]
+ */
+static void CanTp_UpdateTimers(const uint32 elapsed);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function performs one processing step on each N-SDU of the list of active N-SDUs.
+ */
+static void CanTp_ProcessActiveNSdus(void);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#if (CANTP_TICKLESS_SCHEDULING_API == STD_ON)
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function checks if an N-SDU has some work to do which does not depend on a timer
+ * (e.g. a frame waiting to be transmitted or an expired timer).
+ *
+ * @param pNSdu [in]: the N-SDU to check
+ * @return TRUE if the N-SDU shall be processed at the next call of the main function, FALSE
+ * otherwise
+ */
+static boolean CanTp_IsNSduPending(const CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function checks if the upper layer is polled for buffer space on an N-SDU, i.e. if
+ * N_Br is running on a reception without buffer notification (SWS_CanTp_00222).
+ *
+ * @param pNSdu [in]: the N-SDU to check
+ * @return TRUE if the N-SDU shall be processed once per main function period, FALSE otherwise
+ */
+static boolean CanTp_IsNSduPolled(const CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#endif /* #if (CANTP_TICKLESS_SCHEDULING_API == STD_ON) */
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepTx(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function processes a pending consecutive frame transmission request: the CF N-PDU is
+ * encoded and handed over to the lower layer if STmin has elapsed.
+ *
+ * @param pNSdu [in]: the N-SDU on which the consecutive frame is requested
+ */
+static void CanTp_PerformStepTxCF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function hands over the CF encoded in the transmit buffer of a Tx N-SDU to the lower
+ * layer and records it as waiting for its confirmation.
+ *
+ * @param pNSdu [in]: the N-SDU transmitting the consecutive frame
+ */
+static void CanTp_TransmitTxCF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function releases the oldest CF waiting for its confirmation, and observes N_As for
+ * the next one (from its own transmission time) if any.
+ *
+ * @param pNSdu [in]: the N-SDU whose consecutive frame has been confirmed
+ */
+static void CanTp_ReleaseTxCF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function transmits CFs without waiting for the confirmation of the previous ones, as
+ * long as the transmit window of the Tx N-SDU is not full, the receiver requested a STmin of 0 and
+ * the current block is not complete.
+ *
+ * @param pNSdu [in]: the N-SDU transmitting consecutive frames
+ */
+static void CanTp_FillTxWindow(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function returns the handlers of a state of the Rx or Tx state machine. all the
+ * events are dispatched through this function.
+ *
+ * @param direction [in]: CANTP_DIRECTION_RX or CANTP_DIRECTION_TX
+ * @param state [in]: current state of the state machine
+ * @return handlers of the state, the (empty) handlers of CANTP_FRAME_STATE_INVALID if the state
+ * is out of range
+ */
+static const CanTp_StateHandlerType *CanTp_GetStateHandler(const uint8 direction,
+                                                           const CanTp_FrameStateType state);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepRxOK(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepRxAbort(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepTxSF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepTxFF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepTxOK(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_PerformStepTxAbort(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static BufReq_ReturnType CanTp_CopyRxPayload(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static BufReq_ReturnType CanTp_CopyTxPayload(CanTp_NSduType *pNSdu, PduLengthType *pOfs);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief this function copies the payload of the next frame from the staging buffer of a Tx N-SDU,
+ * after requesting as much of the remaining payload as possible from the upper layer if the
+ * staging buffer does not hold enough data for the frame.
+ *
+ * @param pNSdu [in]: the N-SDU being transmitted
+ * @param pPduInfo [in]: destination and size of the payload of the frame
+ *
+ * @return the result of PduR_CanTpCopyTxData, BUFREQ_OK if the upper layer has not been called
+ */
+static BufReq_ReturnType CanTp_CopyTxStagedPayload(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static void CanTp_SetPadding(uint8 *pBuffer, PduLengthType *pOfs, const uint8 value);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataReqTSF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataReqTFF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataReqTCF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataReqRFC(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType
+CanTp_LDataIndRSF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType
+CanTp_LDataIndRFF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType
+CanTp_LDataIndRCF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType
+CanTp_LDataIndTFC(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataConRFC(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataConTSF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataConTFF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+static CanTp_FrameStateType CanTp_LDataConTCF(CanTp_NSduType *pNSdu);
+
+#define CanTp_STOP_SEC_CODE_FAST
+#include "CanTp_MemMap.h"
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* local constant definitions (static const).                                                    */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_C_LCDEF
+ * @{
+ */
+
+#define CanTp_START_SEC_VAR_FAST_INIT_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+static const CanTp_ConfigType *CanTp_ConfigPtr = NULL_PTR;
+
+#define CanTp_STOP_SEC_VAR_FAST_INIT_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_CONST_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief Rx state machine: handlers of each state. SF and FF N-PDUs start a new reception in any
+ * state, they are not dispatched through this table.
+ */
+static const CanTp_StateHandlerType CanTp_RxStateHandler[CANTP_FRAME_STATE_CNT] = {
+    /* CANTP_FRAME_STATE_INVALID */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_TX_REQUEST */
+    {
+        &CanTp_PerformStepRxFC,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        &CanTp_LDataConRFC,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_CF_RX_INDICATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        &CanTp_LDataIndRCF,
+        CANTP_N_PCI_TYPE_CF
+    },
+    /* CANTP_TX_FRAME_STATE_SF_TX_REQUEST */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FF_TX_REQUEST */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_CF_TX_REQUEST */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FC_RX_INDICATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_FRAME_STATE_OK */
+    {
+        &CanTp_PerformStepRxOK,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_FRAME_STATE_ABORT */
+    {
+        &CanTp_PerformStepRxAbort,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    }
+};
+
+/**
+ * @brief Tx state machine: handlers of each state.
+ */
+static const CanTp_StateHandlerType CanTp_TxStateHandler[CANTP_FRAME_STATE_CNT] = {
+    /* CANTP_FRAME_STATE_INVALID */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_TX_REQUEST */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_RX_FRAME_STATE_CF_RX_INDICATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_SF_TX_REQUEST */
+    {
+        &CanTp_PerformStepTxSF,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        &CanTp_LDataConTSF,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FF_TX_REQUEST */
+    {
+        &CanTp_PerformStepTxFF,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        &CanTp_LDataConTFF,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_CF_TX_REQUEST */
+    {
+        &CanTp_PerformStepTxCF,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION */
+    {
+        NULL_PTR,
+        &CanTp_LDataConTCF,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_TX_FRAME_STATE_FC_RX_INDICATION */
+    {
+        NULL_PTR,
+        NULL_PTR,
+        &CanTp_LDataIndTFC,
+        CANTP_N_PCI_TYPE_FC
+    },
+    /* CANTP_FRAME_STATE_OK */
+    {
+        &CanTp_PerformStepTxOK,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    },
+    /* CANTP_FRAME_STATE_ABORT */
+    {
+        &CanTp_PerformStepTxAbort,
+        NULL_PTR,
+        NULL_PTR,
+        0x00u
+    }
+};
+
+#define CanTp_STOP_SEC_CONST_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* local variable definitions (static).                                                          */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_C_LVDEF
+ * @{
+ */
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief idle reception connection referenced by the N-SDUs which are only configured in
+ * transmission.
+ */
+static CanTp_RxConnectionType CanTp_IdleRxConnection;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief idle transmission connection referenced by the N-SDUs which are only configured in
+ * reception.
+ */
+static CanTp_TxConnectionType CanTp_IdleTxConnection;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief reception connection on which the FC(OVFLW) is built when a FF is received while the
+ * reception connection pool is exhausted.
+ */
+static CanTp_RxConnectionType CanTp_OverflowRxConnection;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief counters of the reception and transmission connection pools.
+ */
+static CanTp_ConnectionPoolStatusType CanTp_ConnectionPoolStatus;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief head of the list of N-SDUs with an ongoing reception and/or transmission. this list is
+ * the only one walked by @ref CanTp_MainFunction, so that idle N-SDUs do not cost anything.
+ */
+static CanTp_NSduType *CanTp_ActiveNSdu;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief binary min-heap of all running timers, ordered by deadline. only its root has to be
+ * looked at by @ref CanTp_MainFunction to find out whether a timer has expired. its storage is
+ * provided by the configuration, sized so that all timers of all N-SDUs can be armed at the same
+ * time, hence an insertion never fails.
+ */
+static CanTp_TimerType *CanTp_TimerHeap;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief number of timers currently stored in @ref CanTp_TimerHeap.
+ */
+static uint32 CanTp_TimerCnt;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#define CanTp_START_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+/**
+ * @brief time base of the module [us], advanced by @ref CanTp_MainFunction. it is allowed to wrap
+ * around, deadlines are always compared relatively to it.
+ */
+static uint32 CanTp_Now;
+
+#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* global constant definitions (extern const).                                                   */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_C_GCDEF
+ * @{
+ */
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* global variable definitions (extern).                                                         */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_C_GVDEF
+ * @{
+ */
+
+#define CanTp_START_SEC_VAR_FAST_POWER_ON_INIT_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+CanTp_StateType CanTp_State = CANTP_OFF;
+
+#define CanTp_STOP_SEC_VAR_FAST_POWER_ON_INIT_UNSPECIFIED
+#include "CanTp_MemMap.h"
+
+#ifdef CANTP_BUILD_CFFI_INTERFACE
+
+boolean CanTp_AbortedRxSession = FALSE;
+
+boolean CanTp_AbortedTxSession = FALSE;
+
+#endif /* #ifndef CANTP_BUILD_CFFI_INTERFACE */
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* global function definitions.                                                                  */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_C_GFDEF
+ * @{
+ */
+
+void CanTp_Init(const CanTp_ConfigType *pConfig)
+{
+    uint32_least channel_idx;
+    uint32_least cfg_sdu_idx;
+    uint32 n_sdu_cnt = 0x00u;
+    const CanTp_ChannelType *p_cfg_channel;
+    const CanTp_ChannelRtType *p_rt_channel;
+    const CanTp_PduIdMapType *p_map;
+    CanTp_NSduType *p_rt_sdu;
+    const CanTp_RxNSduType *p_cfg_rx_sdu;
+    const CanTp_TxNSduType *p_cfg_tx_sdu;
+    uint32 tx_request_idx;
+    uint32 tx_staging_idx;
+    uint32 tx_sent_at_idx;
+    uint32 rx_staging_idx;
+    uint32_least peer_idx;
+    CanTp_PeerType *p_peer;
+    boolean valid = TRUE;
+
+#if (CANTP_PRE_COMPILE_VARIANT == STD_ON)
+
+    /* pre-compile variant: the configuration is compiled with the module, pConfig is ignored. */
+    const CanTp_ConfigType *p_config = CANTP_CONFIG_PTR;
+
+    (void)pConfig;
+
+#else
+
+    const CanTp_ConfigType *p_config = pConfig;
+
+#endif /* #if (CANTP_PRE_COMPILE_VARIANT == STD_ON) */
+
+    if ((p_config != NULL_PTR) && (p_config->pChannelRt != NULL_PTR))
+    {
+        CanTp_ConfigPtr = p_config;
+
+        CanTp_ClearMemory(&CanTp_IdleRxConnection, sizeof(CanTp_IdleRxConnection));
+        CanTp_ClearMemory(&CanTp_IdleTxConnection, sizeof(CanTp_IdleTxConnection));
+        CanTp_ClearMemory(&CanTp_ConnectionPoolStatus, sizeof(CanTp_ConnectionPoolStatus));
+
+        CanTp_ActiveNSdu = NULL_PTR;
+        CanTp_TimerHeap = p_config->pTimerHeap;
+        CanTp_TimerCnt = 0x00u;
+        CanTp_Now = 0x00u;
+
+        /* iterate over all statically defined channels, and bind each configured N-SDU to the
+         * runtime slot given by the PduId map generated with the configuration. */
+        for (channel_idx = 0x00u; channel_idx < p_config->maxChannelCnt; channel_idx++)
+        {
+            p_cfg_channel = &p_config->pChannel[channel_idx];
+            p_rt_channel = &p_config->pChannelRt[channel_idx];
+
+            CanTp_ClearMemory(p_rt_channel->pNSdu, p_rt_channel->nSduCnt * sizeof(CanTp_NSduType));
+            tx_request_idx = 0x00u;
+            tx_staging_idx = 0x00u;
+            tx_sent_at_idx = 0x00u;
+            rx_staging_idx = 0x00u;
+
+            for (cfg_sdu_idx = 0x00u; cfg_sdu_idx < p_rt_channel->nSduCnt; cfg_sdu_idx++)
+            {
+                p_rt_channel->pNSdu[cfg_sdu_idx].rx = &CanTp_IdleRxConnection;
+                p_rt_channel->pNSdu[cfg_sdu_idx].tx = &CanTp_IdleTxConnection;
+            }
+
+            n_sdu_cnt += p_rt_channel->nSduCnt;
+
+            for (cfg_sdu_idx = 0x00u;
+                 (p_cfg_channel->nSdu.rx != NULL_PTR) && (cfg_sdu_idx < p_cfg_channel->nSdu.rxNSduCnt);
+                 cfg_sdu_idx++)
+            {
+                p_cfg_rx_sdu = &p_cfg_channel->nSdu.rx[cfg_sdu_idx];
+                p_map = CanTp_GetPduIdMapEntry(p_config, p_cfg_rx_sdu->nSduId, channel_idx);
+
+                if ((p_map != NULL_PTR) &&
+                    ((p_cfg_rx_sdu->rxStagingSize == 0x00u) ||
+                     ((p_cfg_rx_sdu->rxStagingSize >= p_cfg_rx_sdu->rxDl) &&
+                      (p_rt_channel->pRxStaging != NULL_PTR))) &&
+                    ((p_cfg_rx_sdu->dynamicAddressing == FALSE) ||
+                     (((p_cfg_rx_sdu->af == CANTP_NORMALFIXED) || (p_cfg_rx_sdu->af == CANTP_MIXED29BIT)) &&
+                      (p_cfg_rx_sdu->rxStagingSize == 0x00u))) &&
+                    ((p_config->rxConnectionPoolSize == 0x00u) || (p_cfg_rx_sdu->rxStagingSize == 0x00u)))
+                {
+                    p_rt_sdu = &p_rt_channel->pNSdu[p_map->nSdu];
+
+                    p_rt_sdu->channel = p_cfg_channel;
+                    p_rt_sdu->dir |= CANTP_DIRECTION_RX;
+                    p_rt_sdu->dynamic = p_cfg_rx_sdu->dynamicAddressing;
+                    p_rt_sdu->rx_cfg = p_cfg_rx_sdu;
+                    p_rt_sdu->rx_shared.taskState = CANTP_WAIT;
+                    p_rt_sdu->m_param.st_min = p_cfg_rx_sdu->sTMin;
+                    p_rt_sdu->m_param.bs = p_cfg_rx_sdu->bs;
+
+                    /* without reception connection pool, the N-SDU owns a dedicated connection,
+                     * otherwise it is bound to one of the pool on reception of a SF or FF. */
+                    if (p_config->rxConnectionPoolSize == 0x00u)
+                    {
+                        p_rt_sdu->rx = &p_rt_channel->pRxConnection[cfg_sdu_idx];
+                        CanTp_InitRxConnection(p_rt_sdu->rx, p_cfg_rx_sdu);
+                    }
+
+                    if (p_cfg_rx_sdu->rxStagingSize > 0x00u)
+                    {
+                        p_rt_sdu->rx->staging.p_data = &p_rt_channel->pRxStaging[rx_staging_idx];
+                        rx_staging_idx += p_cfg_rx_sdu->rxStagingSize;
+                    }
+                }
+                else
+                {
+                    valid = FALSE;
+                }
+            }
+
+            for (cfg_sdu_idx = 0x00u;
+                 (p_cfg_channel->nSdu.tx != NULL_PTR) && (cfg_sdu_idx < p_cfg_channel->nSdu.txNSduCnt);
+                 cfg_sdu_idx++)
+            {
+                p_cfg_tx_sdu = &p_cfg_channel->nSdu.tx[cfg_sdu_idx];
+                p_map = CanTp_GetPduIdMapEntry(p_config, p_cfg_tx_sdu->nSduId, channel_idx);
+
+                if ((p_map != NULL_PTR) &&
+                    (p_cfg_tx_sdu->txWindow <= CANTP_MAX_TX_WINDOW) &&
+                    ((p_cfg_tx_sdu->txWindow <= 0x01u) || (p_rt_channel->pTxSentAt != NULL_PTR)) &&
+                    ((p_cfg_tx_sdu->txQueueDepth == 0x00u) || (p_rt_channel->pTxRequest != NULL_PTR)) &&
+                    ((p_cfg_tx_sdu->txStagingSize == 0x00u) ||
+                     ((p_cfg_tx_sdu->txStagingSize >= p_cfg_tx_sdu->txDl) &&
+                      (p_rt_channel->pTxStaging != NULL_PTR))) &&
+                    ((p_cfg_tx_sdu->dynamicAddressing == FALSE) ||
+                     (((p_cfg_tx_sdu->af == CANTP_NORMALFIXED) || (p_cfg_tx_sdu->af == CANTP_MIXED29BIT)) &&
+                      (p_cfg_tx_sdu->txStagingSize == 0x00u) &&
+                      (p_cfg_tx_sdu->txQueueDepth == 0x00u) &&
+                      (p_cfg_tx_sdu->txWindow <= 0x01u))) &&
+                    ((p_config->txConnectionPoolSize == 0x00u) ||
+                     ((p_cfg_tx_sdu->txStagingSize == 0x00u) &&
+                      (p_cfg_tx_sdu->txQueueDepth == 0x00u) &&
+                      (p_cfg_tx_sdu->txWindow <= 0x01u))))
+                {
+                    p_rt_sdu = &p_rt_channel->pNSdu[p_map->nSdu];
+
+                    /* both directions of an N-SDU share the same connection pool entry, they must
+                     * agree on the addressing mode. */
+                    if (((p_rt_sdu->dir & CANTP_DIRECTION_RX) != 0x00u) &&
+                        (p_rt_sdu->dynamic != p_cfg_tx_sdu->dynamicAddressing))
+                    {
+                        valid = FALSE;
+                    }
+
+                    p_rt_sdu->channel = p_cfg_channel;
+                    p_rt_sdu->dir |= CANTP_DIRECTION_TX;
+                    p_rt_sdu->dynamic = p_cfg_tx_sdu->dynamicAddressing;
+                    p_rt_sdu->tx_cfg = p_cfg_tx_sdu;
+                    p_rt_sdu->tx_shared.taskState = CANTP_WAIT;
+
+                    /* without transmission connection pool, the N-SDU owns a dedicated connection,
+                     * otherwise it is bound to one of the pool on transmit request. */
+                    if (p_config->txConnectionPoolSize == 0x00u)
+                    {
+                        p_rt_sdu->tx = &p_rt_channel->pTxConnection[cfg_sdu_idx];
+                        CanTp_InitTxConnection(p_rt_sdu->tx, p_cfg_tx_sdu);
+                    }
+
+                    if (p_cfg_tx_sdu->txQueueDepth > 0x00u)
+                    {
+                        p_rt_sdu->tx->queue.p_request = &p_rt_channel->pTxRequest[tx_request_idx];
+                        tx_request_idx += p_cfg_tx_sdu->txQueueDepth;
+                    }
+
+                    if (p_cfg_tx_sdu->txStagingSize > 0x00u)
+                    {
+                        p_rt_sdu->tx->staging.p_data = &p_rt_channel->pTxStaging[tx_staging_idx];
+                        tx_staging_idx += p_cfg_tx_sdu->txStagingSize;
+                    }
+
+                    if (p_cfg_tx_sdu->txWindow > 0x01u)
+                    {
+                        p_rt_sdu->tx->p_sent_at = &p_rt_channel->pTxSentAt[tx_sent_at_idx];
+                        tx_sent_at_idx += p_cfg_tx_sdu->txWindow;
+                    }
+                }
+                else
+                {
+                    valid = FALSE;
+                }
+            }
+        }
+
+        /* the connection pool entries are free until a peer of a dynamically addressed N-SDU is
+         * bound to them, each one owning its reception and transmission connections. */
+        if ((p_config->peerCnt == 0x00u) || (p_config->pPeer != NULL_PTR))
+        {
+            CanTp_ClearMemory(p_config->pPeer, p_config->peerCnt * sizeof(CanTp_PeerType));
+
+            for (peer_idx = 0x00u; peer_idx < p_config->peerCnt; peer_idx++)
+            {
+                p_peer = &p_config->pPeer[peer_idx];
+
+                p_peer->n_sdu.p_peer = p_peer;
+                p_peer->n_sdu.rx = &p_peer->rx;
+                p_peer->n_sdu.tx = &p_peer->tx;
+            }
+
+            n_sdu_cnt += p_config->peerCnt;
+        }
+        else
+        {
+            valid = FALSE;
+        }
+
+        /* the connections of the pools are free (i.e. without configuration) until they are bound
+         * to an N-SDU. */
+        if (((p_config->rxConnectionPoolSize == 0x00u) || (p_config->pRxConnectionPool != NULL_PTR)) &&
+            ((p_config->txConnectionPoolSize == 0x00u) || (p_config->pTxConnectionPool != NULL_PTR)))
+        {
+            CanTp_ClearMemory(p_config->pRxConnectionPool,
+                              p_config->rxConnectionPoolSize * sizeof(CanTp_RxConnectionType));
+            CanTp_ClearMemory(p_config->pTxConnectionPool,
+                              p_config->txConnectionPoolSize * sizeof(CanTp_TxConnectionType));
+        }
+        else
+        {
+            valid = FALSE;
+        }
+
+        /* the timer heap must be able to hold all timers of all N-SDUs at the same time. */
+        if ((n_sdu_cnt * CANTP_NUM_OF_TIMER_PER_N_SDU) > p_config->timerHeapSize)
+        {
+            valid = FALSE;
+        }
+
+        if (valid == TRUE)
+        {
+            CanTp_State = CANTP_ON;
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_INIT_API_ID, CANTP_E_INIT_FAILED);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_INIT_API_ID, CANTP_E_PARAM_POINTER);
+    }
+}
+
+#if (CANTP_GET_VERSION_INFO_API == STD_ON)
+
+void CanTp_GetVersionInfo(Std_VersionInfoType *pVersionInfo)
+{
+    if (pVersionInfo != NULL_PTR)
+    {
+        pVersionInfo->vendorID = 0x00u;
+        pVersionInfo->moduleID = (uint16)CANTP_MODULE_ID;
+        pVersionInfo->sw_major_version = CANTP_SW_MAJOR_VERSION;
+        pVersionInfo->sw_minor_version = CANTP_SW_MINOR_VERSION;
+        pVersionInfo->sw_patch_version = CANTP_SW_PATCH_VERSION;
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_GET_VERSION_INFO_API_ID, CANTP_E_PARAM_POINTER);
+    }
+}
+
+#endif /* #if (CANTP_GET_VERSION_INFO_API == STD_ON) */
+
+void CanTp_Shutdown(void)
+{
+    if ((CanTp_StateType)CanTp_State != (CanTp_StateType)CANTP_OFF)
+    {
+        CanTp_State = CANTP_OFF;
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_SHUTDOWN_API_ID, CANTP_E_UNINIT);
+    }
+
+}
+
+Std_ReturnType CanTp_Transmit(PduIdType txPduId, const PduInfoType *pPduInfo)
+{
+    return CanTp_StartTransmission(txPduId, pPduInfo, NULL_PTR, CANTP_TRANSMIT_API_ID);
+}
+
+#if (CANTP_ZERO_COPY_TRANSMIT_API == STD_ON)
+
+Std_ReturnType CanTp_TransmitBuffer(PduIdType txPduId, const PduInfoType *pPduInfo)
+{
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((pPduInfo != NULL_PTR) && (pPduInfo->SduDataPtr != NULL_PTR))
+    {
+        tmp_return = CanTp_StartTransmission(txPduId,
+                                             pPduInfo,
+                                             pPduInfo->SduDataPtr,
+                                             CANTP_TRANSMIT_BUFFER_API_ID);
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_TRANSMIT_BUFFER_API_ID, CANTP_E_PARAM_POINTER);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_ZERO_COPY_TRANSMIT_API == STD_ON) */
+
+static Std_ReturnType CanTp_StartTransmission(PduIdType txPduId,
+                                              const PduInfoType *pPduInfo,
+                                              const uint8 *pData,
+                                              const uint8 serviceId)
+{
+    CanTp_NSduType *p_n_sdu = NULL_PTR;
+    CanTp_TxRequestType request;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pPduInfo != NULL_PTR)
+        {
+            if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
+                ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u))
+            {
+                request.p_data = pData;
+                request.length = pPduInfo->SduLength;
+
+                /* non-standard: the session of a dynamically addressed N-SDU runs on the connection
+                 * pool entry bound to the peer identified by the meta data, the request is rejected
+                 * if no entry is available. */
+                if ((p_n_sdu->dynamic == TRUE) &&
+                    (CanTp_BindPeer(&p_n_sdu, pPduInfo->MetaDataPtr, FALSE) != E_OK))
+                {
+                    /* MISRA C, do nothing. */
+                }
+                /* SWS_CanTp_00206: the function CanTp_Transmit shall reject a request if the CanTp_Transmit
+                 * service is called for a N-SDU identifier which is being used in a currently running CAN
+                 * Transport Layer session. */
+                else if ((p_n_sdu->tx_shared.taskState != CANTP_PROCESSING) &&
+                         (pPduInfo->SduLength > 0x0000u))
+                {
+                    /* non-standard: the session runs on a connection of the transmission connection
+                     * pool, the request is rejected if no connection is available. */
+                    if (CanTp_BindTxConnection(p_n_sdu) == E_OK)
+                    {
+                        tmp_return = CanTp_GetTxStartState(p_n_sdu, request.length, serviceId, &request.state);
+                    }
+
+                    if (tmp_return == E_OK)
+                    {
+                        CanTp_BeginTxSession(p_n_sdu, &request);
+                        CanTp_ActivateNSdu(p_n_sdu);
+                    }
+                }
+                else if ((p_n_sdu->tx_cfg->txQueueDepth > 0x00u) && (pPduInfo->SduLength > 0x0000u))
+                {
+                    /* non-standard: instead of being rejected, the request is queued and its session
+                     * starts as soon as the ongoing one ends. */
+                    if (CanTp_GetTxStartState(p_n_sdu, request.length, serviceId, &request.state) == E_OK)
+                    {
+                        tmp_return = CanTp_EnqueueTxRequest(p_n_sdu, &request);
+                    }
+                }
+                else
+                {
+                    /* MISRA C, do nothing. */
+                }
+
+                /* a connection pool entry or a connection bound for a rejected request is given
+                 * back. */
+                CanTp_ReleaseNSdu(p_n_sdu);
+            }
+            else
+            {
+                CanTp_ReportError(0x00u, serviceId, CANTP_E_INVALID_TX_ID);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, serviceId, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, serviceId, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+Std_ReturnType CanTp_CancelTransmit(PduIdType txPduId)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
+            ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u))
+        {
+            if (CanTp_GetSessionNSdu(&p_n_sdu, CANTP_DIRECTION_TX) != E_OK)
+            {
+                CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_AMBIGUOUS_PEER);
+            }
+            else if (p_n_sdu->tx_shared.taskState == CANTP_PROCESSING)
+            {
+                p_n_sdu->tx_shared.taskState = CANTP_WAIT;
+
+                CanTp_EndTxStall(p_n_sdu);
+
+                /* SWS_CanTp_00255: If the CanTp_CancelTransmit service has been successfully executed
+                 * the CanTp shall call the PduR_CanTpTxConfirmation with notification result E_NOT_OK.
+                 */
+                PduR_CanTpTxConfirmation(p_n_sdu->tx->cfg->nSduId, E_NOT_OK);
+
+                (void)CanTp_StartNextTxRequest(p_n_sdu);
+
+                tmp_return = E_OK;
+            }
+            else
+            {
+                /* SWS_CanTp_00254: if development error detection is enabled the function
+                 * CanTp_CancelTransmit shall check the validity of TxPduId parameter. If the parameter
+                 * value is invalid, the CanTp_CancelTransmit function shall raise the development error
+                 * CANTP_E_PARAM_ID and return E_NOT_OK (see SWS_CanTp_00294).
+                 * if the parameter value indicates a cancel transmission request for an N-SDU that it
+                 * is not on transmission process the CanTp module shall report a runtime error code
+                 * CANTP_E_OPER_NOT_SUPPORTED to the Default Error Tracer and the service shall return
+                 * E_NOT_OK. */
+                CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_OPER_NOT_SUPPORTED);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_PARAM_ID);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+Std_ReturnType CanTp_CancelReceive(PduIdType rxPduId)
+{
+    CanTp_NSduType *p_n_sdu;
+    CanTp_TaskStateType task_state;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if ((CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK) &&
+            ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
+        {
+            if (CanTp_GetSessionNSdu(&p_n_sdu, CANTP_DIRECTION_RX) != E_OK)
+            {
+                CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_AMBIGUOUS_PEER);
+            }
+            else
+            {
+                CANTP_ENTER_CRITICAL_SECTION
+                task_state = p_n_sdu->rx_shared.taskState;
+                CANTP_EXIT_CRITICAL_SECTION
+
+                if (task_state == CANTP_PROCESSING)
+                {
+                    /* SWS_CanTp_00262: The CanTp shall reject the request for receive cancellation
+                     * in case of a Single Frame reception or if the CanTp is in the process of
+                     * receiving the last Consecutive Frame of the N-SDU (i.e. the service is called
+                     * after N-Cr timeout is started for the last Consecutive Frame). In this case
+                     * the CanTp shall return E_NOT_OK. */
+                    if (p_n_sdu->rx->buf.size >
+                        ((p_n_sdu->rx->dl - CANTP_CF_PCI_FIELD_SIZE) + CanTp_GetNAiSize(&p_n_sdu->rx->geometry)))
+                    {
+                        CANTP_ENTER_CRITICAL_SECTION
+                        p_n_sdu->rx_shared.taskState = CANTP_WAIT;
+                        CANTP_EXIT_CRITICAL_SECTION
+
+                        /* SWS_CanTp_00263: if the CanTp_CancelReceive service has been successfully
+                         * executed the CanTp shall call the PduR_CanTpRxIndication with
+                         * notification result E_NOT_OK. */
+                        PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+
+                        tmp_return = E_OK;
+                    }
+                }
+                else
+                {
+                    /* SWS_CanTp_00260: If the parameter value indicates a cancel reception request
+                     * for an N-SDU that it is not on reception process the CanTp module shall
+                     * report the runtime error code CANTP_E_OPER_NOT_SUPPORTED to the Default Error
+                     * Tracer and the service shall return E_NOT_OK. */
+                    CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_OPER_NOT_SUPPORTED);
+                }
+            }
+        }
+        else
+        {
+            /* SWS_CanTp_00260: if development error detection is enabled the function
+             * CanTp_CancelReceive shall check the validity of RxPduId parameter. if the parameter
+             * value is invalid, the CanTp_CancelReceive function shall raise the development error
+             * CANTP_E_PARAM_ID and return E_NOT_OK (see SWS_CanTp_00294). */
+            CanTp_ReportError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_PARAM_ID);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#if (CANTP_ZERO_COPY_RECEIVE_API == STD_ON)
+
+Std_ReturnType CanTp_SetRxBuffer(PduIdType rxPduId, uint8 *pBuffer, PduLengthType bufferSize)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pBuffer != NULL_PTR)
+        {
+            if ((CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK) &&
+                ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
+            {
+                if (CanTp_GetSessionNSdu(&p_n_sdu, CANTP_DIRECTION_RX) != E_OK)
+                {
+                    CanTp_ReportRuntimeError(0x00u, CANTP_SET_RX_BUFFER_API_ID, CANTP_E_AMBIGUOUS_PEER);
+                }
+                else if (p_n_sdu->rx_shared.taskState == CANTP_PROCESSING)
+                {
+                    p_n_sdu->rx->dst.p_data = pBuffer;
+                    p_n_sdu->rx->dst.size = bufferSize;
+
+                    tmp_return = E_OK;
+                }
+            }
+            else
+            {
+                CanTp_ReportError(0x00u, CANTP_SET_RX_BUFFER_API_ID, CANTP_E_PARAM_ID);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_SET_RX_BUFFER_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_SET_RX_BUFFER_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_ZERO_COPY_RECEIVE_API == STD_ON) */
+
+#if (CANTP_TX_QUEUE_STATUS_API == STD_ON)
+
+Std_ReturnType CanTp_GetTxQueueStatus(PduIdType txPduId, CanTp_TxQueueStatusType *pStatus)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pStatus != NULL_PTR)
+        {
+            if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
+                ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u) &&
+                (p_n_sdu->dynamic == FALSE))
+            {
+                CANTP_ENTER_CRITICAL_SECTION
+                *pStatus = p_n_sdu->tx->queue.status;
+                CANTP_EXIT_CRITICAL_SECTION
+
+                tmp_return = E_OK;
+            }
+            else
+            {
+                CanTp_ReportError(0x00u, CANTP_GET_TX_QUEUE_STATUS_API_ID, CANTP_E_PARAM_ID);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_GET_TX_QUEUE_STATUS_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_GET_TX_QUEUE_STATUS_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_TX_QUEUE_STATUS_API == STD_ON) */
+
+#if (CANTP_TX_MAILBOX_FREE_API == STD_ON)
+
+void CanTp_TxMailboxFree(void)
+{
+    CanTp_NSduType *p_n_sdu;
+    CanTp_NSduType *p_next_n_sdu;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+        p_n_sdu = CanTp_ActiveNSdu;
+        CANTP_EXIT_CRITICAL_SECTION
+
+        while (p_n_sdu != NULL_PTR)
+        {
+            CANTP_ENTER_CRITICAL_SECTION
+            p_next_n_sdu = p_n_sdu->active.next;
+            CANTP_EXIT_CRITICAL_SECTION
+
+            if ((p_n_sdu->rx_shared.taskState == CANTP_PROCESSING) && (p_n_sdu->rx->retry == TRUE))
+            {
+                CanTp_RetryRxCANData(p_n_sdu);
+            }
+
+            if ((p_n_sdu->tx_shared.taskState == CANTP_PROCESSING) && (p_n_sdu->tx->retry == TRUE))
+            {
+                CanTp_RetryTxCANData(p_n_sdu);
+            }
+
+            p_n_sdu = p_next_n_sdu;
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_TX_MAILBOX_FREE_API_ID, CANTP_E_UNINIT);
+    }
+}
+
+#endif /* #if (CANTP_TX_MAILBOX_FREE_API == STD_ON) */
+
+#if (CANTP_RX_BUFFER_AVAILABLE_API == STD_ON)
+
+Std_ReturnType CanTp_RxBufferAvailable(PduIdType rxPduId, PduLengthType bufferSize)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if ((CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK) &&
+            ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
+        {
+            if (CanTp_GetSessionNSdu(&p_n_sdu, CANTP_DIRECTION_RX) != E_OK)
+            {
+                CanTp_ReportRuntimeError(0x00u, CANTP_RX_BUFFER_AVAILABLE_API_ID, CANTP_E_AMBIGUOUS_PEER);
+            }
+            else if ((p_n_sdu->rx_shared.taskState == CANTP_PROCESSING) &&
+                     (p_n_sdu->rx->fs == CANTP_FLOW_STATUS_TYPE_WT))
+            {
+                p_n_sdu->rx->buf.rmng = bufferSize;
+
+                /* the FC(CTS) is sent right away, unless a FC(WAIT) is waiting for its
+                 * confirmation: it is then sent by the next main function call. */
+                if ((p_n_sdu->rx_shared.state == CANTP_RX_FRAME_STATE_FC_TX_REQUEST) &&
+                    (p_n_sdu->rx->buf.rmng >= CanTp_GetRxBlockSize(p_n_sdu)))
+                {
+                    CanTp_PerformStepRxFC(p_n_sdu);
+                }
+
+                tmp_return = E_OK;
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_RX_BUFFER_AVAILABLE_API_ID, CANTP_E_PARAM_ID);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_RX_BUFFER_AVAILABLE_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_RX_BUFFER_AVAILABLE_API == STD_ON) */
+
+#if (CANTP_TX_DATA_AVAILABLE_API == STD_ON)
+
+Std_ReturnType CanTp_TxDataAvailable(PduIdType txPduId)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
+            ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u))
+        {
+            if (CanTp_GetSessionNSdu(&p_n_sdu, CANTP_DIRECTION_TX) != E_OK)
+            {
+                CanTp_ReportRuntimeError(0x00u, CANTP_TX_DATA_AVAILABLE_API_ID, CANTP_E_AMBIGUOUS_PEER);
+            }
+            else
+            {
+                /* the frame is requested again by the next main function call, which owns the
+                 * state machine of the N-SDU. a CF still waits for STmin. */
+                CANTP_ENTER_CRITICAL_SECTION
+
+                if ((p_n_sdu->tx_shared.taskState == CANTP_PROCESSING) &&
+                    (p_n_sdu->tx->stall.active == TRUE))
+                {
+                    p_n_sdu->tx->stall.resume = TRUE;
+
+                    tmp_return = E_OK;
+                }
+
+                CANTP_EXIT_CRITICAL_SECTION
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_TX_DATA_AVAILABLE_API_ID, CANTP_E_PARAM_ID);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_TX_DATA_AVAILABLE_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_TX_DATA_AVAILABLE_API == STD_ON) */
+
+#if (CANTP_TX_STALL_STATUS_API == STD_ON)
+
+Std_ReturnType CanTp_GetTxStallStatus(PduIdType txPduId, CanTp_TxStallStatusType *pStatus)
+{
+    CanTp_NSduType *p_n_sdu;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pStatus != NULL_PTR)
+        {
+            if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
+                ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u) &&
+                (p_n_sdu->dynamic == FALSE))
+            {
+                CANTP_ENTER_CRITICAL_SECTION
+                *pStatus = p_n_sdu->tx->stall.status;
+                CANTP_EXIT_CRITICAL_SECTION
+
+                tmp_return = E_OK;
+            }
+            else
+            {
+                CanTp_ReportError(0x00u, CANTP_GET_TX_STALL_STATUS_API_ID, CANTP_E_PARAM_ID);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_GET_TX_STALL_STATUS_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_GET_TX_STALL_STATUS_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_TX_STALL_STATUS_API == STD_ON) */
+
+#if (CANTP_CONNECTION_POOL_STATUS_API == STD_ON)
+
+Std_ReturnType CanTp_GetConnectionPoolStatus(CanTp_ConnectionPoolStatusType *pStatus)
+{
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pStatus != NULL_PTR)
+        {
+            CANTP_ENTER_CRITICAL_SECTION
+            *pStatus = CanTp_ConnectionPoolStatus;
+            CANTP_EXIT_CRITICAL_SECTION
+
+            tmp_return = E_OK;
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_GET_CONNECTION_POOL_STATUS_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_GET_CONNECTION_POOL_STATUS_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_CONNECTION_POOL_STATUS_API == STD_ON) */
+
+#if (CANTP_CHANGE_PARAMETER_API == STD_ON)
+
+Std_ReturnType CanTp_ChangeParameter(PduIdType pduId, TPParameterType parameter, uint16 value)
+{
+    CanTp_NSduType *p_n_sdu;
+    CanTp_TaskStateType task_state;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+
+        if (CanTp_GetNSduFromPduId(pduId, &p_n_sdu) == E_OK)
+        {
+            CANTP_ENTER_CRITICAL_SECTION
+            task_state = p_n_sdu->rx_shared.taskState;
+            CANTP_EXIT_CRITICAL_SECTION
+
+            if (task_state != CANTP_PROCESSING)
+            {
+                switch (parameter)
+                {
+                    case TP_STMIN:
+                    {
+                        if ((value <= 0xFFu) && ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
+                        {
+                            CANTP_ENTER_CRITICAL_SECTION
+                            p_n_sdu->m_param.st_min = value;
+                            CANTP_EXIT_CRITICAL_SECTION
 
-#define CanTp_STOP_SEC_VAR_FAST_CLEARED_UNSPECIFIED
-#include "CanTp_MemMap.h"
+                            tmp_return = E_OK;
+                        }
 
-/** @} */
+                        break;
+                    }
+                    case TP_BS:
+                    {
+                        if ((value <= 0xFFu) && ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
+                        {
+                            CANTP_ENTER_CRITICAL_SECTION
+                            p_n_sdu->m_param.bs = (uint8)value;
+                            CANTP_EXIT_CRITICAL_SECTION
 
+                            tmp_return = E_OK;
+                        }
 
-/*-----------------------------------------------------------------------------------------------*/
-/* global constant definitions (extern const).                                                   */
-/*-----------------------------------------------------------------------------------------------*/
+                        break;
+                    }
+                    case TP_BC:
+                    default:
+                    {
+                        break;
+                    }
+                }
 
-/**
- * @addtogroup CANTP_C_GCDEF
- * @{
- */
+                if (tmp_return != E_OK)
+                {
+                    CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+                }
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+        }
+
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_CHANGE_PARAMETER_API == STD_ON) */
+
+#if (CANTP_READ_PARAMETER_API == STD_ON)
+
+Std_ReturnType CanTp_ReadParameter(PduIdType pduId, TPParameterType parameter, uint16 *pValue)
+{
+    CanTp_NSduType *p_n_sdu;
+    uint16 value;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pValue != NULL_PTR)
+        {
+            if (CanTp_GetNSduFromPduId(pduId, &p_n_sdu) == E_OK)
+            {
+                if ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u)
+                {
+                    switch (parameter)
+                    {
+                        case TP_STMIN:
+                        {
+                            CANTP_ENTER_CRITICAL_SECTION
+                            value = (uint16)p_n_sdu->m_param.st_min;
+                            CANTP_EXIT_CRITICAL_SECTION
+
+                            *pValue = value;
+                            tmp_return = E_OK;
+
+                            break;
+                        }
+                        case TP_BS:
+                        {
+                            CANTP_ENTER_CRITICAL_SECTION
+                            value = (uint16)p_n_sdu->m_param.bs;
+                            CANTP_EXIT_CRITICAL_SECTION
+
+                            *pValue = value;
+                            tmp_return = E_OK;
+
+                            break;
+                        }
+                        case TP_BC:
+                        default:
+                        {
+                            CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+
+                            break;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_READ_PARAMETER_API == STD_ON) */
+
+#if (CANTP_TICKLESS_SCHEDULING_API == STD_ON)
+
+Std_ReturnType CanTp_GetNextDeadline(uint32 *pDeadline)
+{
+    CanTp_NSduType *p_n_sdu;
+    uint32 deadline = 0x00u;
+    boolean polled = FALSE;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        if (pDeadline != NULL_PTR)
+        {
+            CANTP_ENTER_CRITICAL_SECTION
+
+            for (p_n_sdu = CanTp_ActiveNSdu; p_n_sdu != NULL_PTR; p_n_sdu = p_n_sdu->active.next)
+            {
+                if (CanTp_IsNSduPending(p_n_sdu) == TRUE)
+                {
+                    tmp_return = E_OK;
+
+                    break;
+                }
+
+                if (CanTp_IsNSduPolled(p_n_sdu) == TRUE)
+                {
+                    polled = TRUE;
+                }
+            }
+
+            /* otherwise, the next event is the earliest deadline, which is the root of the timer
+             * heap. */
+            if ((tmp_return != E_OK) && (CanTp_TimerCnt > 0x00u))
+            {
+                if (CanTp_DeadlineBefore(CanTp_Now, CanTp_TimerHeap[0x00u].deadline) == TRUE)
+                {
+                    deadline = CanTp_TimerHeap[0x00u].deadline - CanTp_Now;
+                }
+
+                /* the upper layer is polled once per main function period, as with a cyclic
+                 * scheduling, rather than at each call. */
+                if ((polled == TRUE) && (deadline > CANTP_CONFIG_PTR->mainFunctionPeriod))
+                {
+                    deadline = CANTP_CONFIG_PTR->mainFunctionPeriod;
+                }
+
+                tmp_return = E_OK;
+            }
+
+            CANTP_EXIT_CRITICAL_SECTION
+
+            if (tmp_return == E_OK)
+            {
+                *pDeadline = deadline;
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_GET_NEXT_DEADLINE_API_ID, CANTP_E_PARAM_POINTER);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_GET_NEXT_DEADLINE_API_ID, CANTP_E_UNINIT);
+    }
+
+    return tmp_return;
+}
+
+#endif /* #if (CANTP_TICKLESS_SCHEDULING_API == STD_ON) */
 
 /** @} */
 
 
 /*-----------------------------------------------------------------------------------------------*/
-/* global variable definitions (extern).                                                         */
+/* global scheduled function definitions.                                                        */
 /*-----------------------------------------------------------------------------------------------*/
 
 /**
- * @addtogroup CANTP_C_GVDEF
+ * @addtogroup CANTP_C_GSFDEF
  * @{
  */
 
-#define CanTp_START_SEC_VAR_FAST_POWER_ON_INIT_UNSPECIFIED
-#include "CanTp_MemMap.h"
-
-CanTp_StateType CanTp_State = CANTP_OFF;
-
-#define CanTp_STOP_SEC_VAR_FAST_POWER_ON_INIT_UNSPECIFIED
-#include "CanTp_MemMap.h"
+void CanTp_MainFunction(void)
+{
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        CanTp_ProcessActiveNSdus();
 
-#ifdef CANTP_BUILD_CFFI_INTERFACE
+        /* timers are evaluated at the end of the period, therefore a timer started during this
+         * call or before the next one expires after ceil(timeout / period) calls. */
+        CanTp_UpdateTimers(CANTP_CONFIG_PTR->mainFunctionPeriod);
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_MAIN_FUNCTION_API_ID, CANTP_E_UNINIT);
+    }
+}
 
-boolean CanTp_AbortedRxSession = FALSE;
+#if (CANTP_TICKLESS_SCHEDULING_API == STD_ON)
 
-boolean CanTp_AbortedTxSession = FALSE;
+void CanTp_MainFunctionElapsed(uint32 elapsed)
+{
+    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    {
+        /* the elapsed time is the one since the previous call, so timers are updated first to
+         * let expired ones be handled right away. */
+        CanTp_UpdateTimers(elapsed);
+        CanTp_ProcessActiveNSdus();
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_MAIN_FUNCTION_ELAPSED_API_ID, CANTP_E_UNINIT);
+    }
+}
 
-#endif /* #ifndef CANTP_BUILD_CFFI_INTERFACE */
+#endif /* #if (CANTP_TICKLESS_SCHEDULING_API == STD_ON) */
 
 /** @} */
 
 
 /*-----------------------------------------------------------------------------------------------*/
-/* global function definitions.                                                                  */
+/* global callback function definitions.                                                         */
 /*-----------------------------------------------------------------------------------------------*/
 
 /**
- * @addtogroup CANTP_C_GFDEF
+ * @addtogroup CANTP_C_GCFDEF
  * @{
  */
 
-void CanTp_Init(const CanTp_ConfigType *pConfig)
+static void CanTp_StartTimer(CanTp_NSduType *pNSdu, const uint8 instanceId, const uint32 timeout)
 {
-    uint32_least channel_idx;
-    uint32_least rt_sdu_idx;
-    uint32_least cfg_sdu_idx;
-    const CanTp_ChannelType *p_cfg_channel;
-    CanTp_ChannelRtType *p_rt_channel;
-    CanTp_NSduType *p_rt_sdu;
-    const CanTp_RxNSduType *p_cfg_rx_sdu;
-    const CanTp_TxNSduType *p_cfg_tx_sdu;
+    const uint32 mask = (uint32)0x01u << instanceId;
+    uint32_least idx;
 
-    if (pConfig != NULL_PTR)
-    {
-        CanTp_ConfigPtr = pConfig;
+    CANTP_ENTER_CRITICAL_SECTION
 
-        uint8 *p_cleared_data = (uint8 *)&CanTp_Rt[0x00u];
-        uint32_least idx;
+    if ((pNSdu->timer.active & mask) == 0x00u)
+    {
+        pNSdu->timer.active |= mask;
 
-        for (idx = 0x00u; idx < sizeof(CanTp_Rt); idx++)
+        if (timeout == 0x00u)
         {
-            p_cleared_data[idx] = 0x00u;
+            pNSdu->timer.expired |= mask;
         }
-        /* iterate over all statically defined channels. */
-        for (channel_idx = 0x00u; channel_idx < pConfig->maxChannelCnt; channel_idx++)
+        else
         {
-            p_rt_channel = &CanTp_Rt[channel_idx];
-            p_cfg_channel = &pConfig->pChannel[channel_idx];
+            pNSdu->timer.expired &= ~mask;
 
-            for (rt_sdu_idx = 0x00u; rt_sdu_idx < (uint32_least)CANTP_MAX_NUM_OF_N_SDU; rt_sdu_idx++)
-            {
-                for (cfg_sdu_idx = 0x00u;
-                     cfg_sdu_idx < p_cfg_channel->nSdu.rxNSduCnt; cfg_sdu_idx++)
-                {
-                    if (p_cfg_channel->nSdu.rx != NULL_PTR)
-                    {
-                        p_cfg_rx_sdu = &p_cfg_channel->nSdu.rx[cfg_sdu_idx];
+            idx = CanTp_TimerCnt;
+            CanTp_TimerCnt++;
 
-                        if (p_cfg_rx_sdu->nSduId == rt_sdu_idx)
-                        {
-                            p_rt_sdu = &p_rt_channel->sdu[p_cfg_rx_sdu->nSduId];
+            CanTp_TimerHeap[idx].deadline = CanTp_Now + timeout;
+            CanTp_TimerHeap[idx].p_n_sdu = pNSdu;
+            CanTp_TimerHeap[idx].instance_id = instanceId;
+            pNSdu->timer_idx[instanceId] = (uint32)idx;
 
-                            p_rt_sdu->dir |= CANTP_DIRECTION_RX;
-                            p_rt_sdu->rx.cfg = p_cfg_rx_sdu;
-                            p_rt_sdu->rx.shared.taskState = CANTP_WAIT;
-                            p_rt_sdu->rx.shared.m_param.st_min = p_cfg_rx_sdu->sTMin;
-                            p_rt_sdu->rx.shared.m_param.bs = p_cfg_rx_sdu->bs;
-                        }
-                    }
-                }
+            CanTp_SiftTimerUp(idx);
+        }
+    }
 
-                for (cfg_sdu_idx = 0x00u;
-                     cfg_sdu_idx < p_cfg_channel->nSdu.txNSduCnt; cfg_sdu_idx++)
-                {
-                    if (p_cfg_channel->nSdu.tx != NULL_PTR)
-                    {
-                        p_cfg_tx_sdu = &p_cfg_channel->nSdu.tx[cfg_sdu_idx];
+    CANTP_EXIT_CRITICAL_SECTION
+}
 
-                        if (p_cfg_tx_sdu->nSduId == rt_sdu_idx)
-                        {
-                            p_rt_sdu = &p_rt_channel->sdu[p_cfg_tx_sdu->nSduId];
+static void CanTp_StartNetworkLayerTimeout(CanTp_NSduType *pNSdu, const uint8 instanceId)
+{
+    CanTp_StartTimer(pNSdu, instanceId, CanTp_GetTimeout(pNSdu, instanceId));
+}
 
-                            p_rt_sdu->dir |= CANTP_DIRECTION_TX;
-                            p_rt_sdu->tx.cfg = p_cfg_tx_sdu;
-                            p_rt_sdu->tx.taskState = CANTP_WAIT;
-                        }
-                    }
-                }
-            }
-        }
+static void CanTp_StopNetworkLayerTimeout(CanTp_NSduType *pNSdu, const uint8 instanceId)
+{
+    const uint32 mask = (uint32)0x01u << instanceId;
+
+    CANTP_ENTER_CRITICAL_SECTION
+
+    /* an expired timer has already been removed from the heap. */
+    if (((pNSdu->timer.active & mask) != 0x00u) && ((pNSdu->timer.expired & mask) == 0x00u))
+    {
+        CanTp_RemoveTimer((uint32_least)pNSdu->timer_idx[instanceId]);
+    }
+
+    pNSdu->timer.active &= ~mask;
+    pNSdu->timer.expired &= ~mask;
+
+    CANTP_EXIT_CRITICAL_SECTION
+}
+
+static boolean CanTp_NetworkLayerTimeoutExpired(const CanTp_NSduType *pNSdu, const uint8 instanceId)
+{
+    boolean result = FALSE;
 
-        CanTp_State = CANTP_ON;
-    }
-    else
+    if ((pNSdu->timer.expired & ((uint32)0x01u << instanceId)) != 0x00u)
     {
-        CanTp_ReportError(0x00u, CANTP_INIT_API_ID, CANTP_E_PARAM_POINTER);
+        result = TRUE;
     }
-}
 
-#if (CANTP_GET_VERSION_INFO_API == STD_ON)
+    return result;
+}
 
-void CanTp_GetVersionInfo(Std_VersionInfoType *pVersionInfo)
+static boolean CanTp_NetworkLayerIsActive(const CanTp_NSduType *pNSdu, const uint8 instanceId)
 {
-    if (pVersionInfo != NULL_PTR)
+    boolean result;
+
+    if ((pNSdu->timer.active & ((uint32)0x01u << instanceId)) == 0x00u)
     {
-        pVersionInfo->vendorID = 0x00u;
-        pVersionInfo->moduleID = (uint16)CANTP_MODULE_ID;
-        pVersionInfo->sw_major_version = CANTP_SW_MAJOR_VERSION;
-        pVersionInfo->sw_minor_version = CANTP_SW_MINOR_VERSION;
-        pVersionInfo->sw_patch_version = CANTP_SW_PATCH_VERSION;
+        result = FALSE;
     }
     else
     {
-        CanTp_ReportError(0x00u, CANTP_GET_VERSION_INFO_API_ID, CANTP_E_PARAM_POINTER);
+        result = TRUE;
     }
+
+    return result;
 }
 
-#endif /* #if (CANTP_GET_VERSION_INFO_API == STD_ON) */
+static void CanTp_StartFlowControlTimeout(CanTp_NSduType *pNSdu)
+{
+    CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_ST_MIN);
+}
 
-void CanTp_Shutdown(void)
+static boolean CanTp_FlowControlActive(const CanTp_NSduType *pNSdu)
 {
-    if ((CanTp_StateType)CanTp_State != (CanTp_StateType)CANTP_OFF)
-    {
-        CanTp_State = CANTP_OFF;
-    }
-    else
+    return CanTp_NetworkLayerIsActive(pNSdu, CANTP_I_ST_MIN);
+}
+
+static boolean CanTp_FlowControlExpired(CanTp_NSduType *pNSdu)
+{
+    boolean result = FALSE;
+
+    if (CanTp_NetworkLayerTimeoutExpired(pNSdu, CANTP_I_ST_MIN) == TRUE)
     {
-        CanTp_ReportError(0x00u, CANTP_SHUTDOWN_API_ID, CANTP_E_UNINIT);
+        result = TRUE;
+        CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_ST_MIN);
     }
 
+    return result;
 }
 
-Std_ReturnType CanTp_Transmit(PduIdType txPduId, const PduInfoType *pPduInfo)
+static CanTp_FrameStateType CanTp_LDataReqTSF(CanTp_NSduType *pNSdu)
 {
-    CanTp_NSduType *p_n_sdu = NULL_PTR;
-    Std_ReturnType tmp_return = E_NOT_OK;
+    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_SF_TX_REQUEST;
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    PduInfoType *p_pdu_info = &p_n_sdu->tx->can_if_pdu_info;
+    PduLengthType ofs = 0x00u;
 
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    p_pdu_info->SduDataPtr = &p_n_sdu->tx->buf.can[0x00u];
+
+    if (p_n_sdu->tx->geometry.n_ai_valid == TRUE)
     {
-        if (pPduInfo != NULL_PTR)
-        {
-            if (CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK)
-            {
-                /* SWS_CanTp_00206: the function CanTp_Transmit shall reject a request if the CanTp_Transmit
-                 * service is called for a N-SDU identifier which is being used in a currently running CAN
-                 * Transport Layer session. */
-                if ((p_n_sdu->tx.taskState != CANTP_PROCESSING) &&
-                    (pPduInfo->SduLength > 0x0000u) &&
-                    (pPduInfo->SduLength <= 0x0FFFu))
-                {
-                    p_n_sdu->tx.buf.size = pPduInfo->SduLength;
-
-                    if ((((p_n_sdu->tx.cfg->af == CANTP_STANDARD) ||
-                          (p_n_sdu->tx.cfg->af == CANTP_NORMALFIXED)) &&
-                         (pPduInfo->SduLength <= 0x07u)) ||
-                        (((p_n_sdu->tx.cfg->af == CANTP_EXTENDED) ||
-                          (p_n_sdu->tx.cfg->af == CANTP_MIXED) ||
-                          (p_n_sdu->tx.cfg->af == CANTP_MIXED29BIT)) &&
-                         (pPduInfo->SduLength <= 0x06u)))
-                    {
-                        p_n_sdu->tx.shared.state = CANTP_TX_FRAME_STATE_SF_TX_REQUEST;
-                        tmp_return = E_OK;
-                    }
-                    else
-                    {
-                        if (p_n_sdu->tx.cfg->taType == CANTP_PHYSICAL)
-                        {
-                            p_n_sdu->tx.shared.state = CANTP_TX_FRAME_STATE_FF_TX_REQUEST;
-                            tmp_return = E_OK;
-                        }
-                        else
-                        {
-                            /* SWS_CanTp_00093: If a multiple segmented session occurs (on both receiver and
-                             * sender  side) with a handle whose communication type is functional, the CanTp
-                             * module shall reject the request and report the runtime error code
-                             * CANTP_E_INVALID_TATYPE to the Default Error Tracer. */
-                            CanTp_ReportRuntimeError(0x00u, CANTP_TRANSMIT_API_ID,
-                                                     CANTP_E_INVALID_TATYPE);
-                        }
-                    }
+        p_pdu_info->SduDataPtr[0x00u] = p_n_sdu->tx->geometry.n_ai;
+        ofs = CanTp_GetNAiSize(&p_n_sdu->tx->geometry);
 
-                    if (tmp_return == E_OK)
-                    {
-                        p_n_sdu->tx.taskState = CANTP_PROCESSING;
-                    }
-                }
-            }
-            else
-            {
-                CanTp_ReportError(0x00u, CANTP_TRANSMIT_API_ID, CANTP_E_INVALID_TX_ID);
-            }
+        if ((ofs + CANTP_SF_PCI_FIELD_SIZE + pNSdu->tx->buf.size) <= CANTP_CAN_FRAME_SIZE)
+        {
+            /* prevent lint issue by providing zero valued rhs argument to operators '<<' and '|'. */
+            p_pdu_info->SduDataPtr[ofs] = /* (uint8)((uint8)CANTP_N_PCI_TYPE_SF << 0x04u) | */
+                (uint8)pNSdu->tx->buf.size;
+            ofs = ofs + 0x01u;
         }
         else
         {
-            CanTp_ReportError(0x00u, CANTP_TRANSMIT_API_ID, CANTP_E_PARAM_POINTER);
+            /* the payload does not fit into a CAN 2.0 frame: the SF_DL escape sequence is used, the
+             * low nibble of the N_PCI byte is set to zero and the SF_DL is stored in the next
+             * byte. */
+            p_pdu_info->SduDataPtr[ofs] = 0x00u;
+            ofs = ofs + 0x01u;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)pNSdu->tx->buf.size;
+            ofs = ofs + 0x01u;
         }
-    }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_TRANSMIT_API_ID, CANTP_E_UNINIT);
-    }
-
-    return tmp_return;
-}
-
-Std_ReturnType CanTp_CancelTransmit(PduIdType txPduId)
-{
-    CanTp_NSduType *p_n_sdu;
-    Std_ReturnType tmp_return = E_NOT_OK;
 
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
-    {
-        if ((CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK) &&
-            ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u))
+        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
         {
-            if (p_n_sdu->tx.taskState == CANTP_PROCESSING)
-            {
-                p_n_sdu->tx.taskState = CANTP_WAIT;
-
-                /* SWS_CanTp_00255: If the CanTp_CancelTransmit service has been successfully executed
-                 * the CanTp shall call the PduR_CanTpTxConfirmation with notification result E_NOT_OK.
-                 */
-                PduR_CanTpTxConfirmation(p_n_sdu->tx.cfg->nSduId, E_NOT_OK);
+            tmp_return = CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION;
 
-                tmp_return = E_OK;
-            }
-            else
+            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
+             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
+             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
+             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
+             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
+             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298).
+             *
+             * SWS_CanTp_00351: if a SF or last CF N-PDU with a payload > 8 (large CAN FD frame) does
+             * not match a valid CAN FD data length, it is padded up to the next valid one. */
+            if ((CanTp_GetPaddingActivation(p_n_sdu->tx->cfg->padding) == CANTP_ON) ||
+                (ofs > CANTP_CAN_FRAME_SIZE))
             {
-                /* SWS_CanTp_00254: if development error detection is enabled the function
-                 * CanTp_CancelTransmit shall check the validity of TxPduId parameter. If the parameter
-                 * value is invalid, the CanTp_CancelTransmit function shall raise the development error
-                 * CANTP_E_PARAM_ID and return E_NOT_OK (see SWS_CanTp_00294).
-                 * if the parameter value indicates a cancel transmission request for an N-SDU that it
-                 * is not on transmission process the CanTp module shall report a runtime error code
-                 * CANTP_E_OPER_NOT_SUPPORTED to the Default Error Tracer and the service shall return
-                 * E_NOT_OK. */
-                CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_OPER_NOT_SUPPORTED);
+                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CANTP_CONFIG_PTR->paddingByte);
             }
+
+            p_pdu_info->SduLength = ofs;
         }
-        else
-        {
-            CanTp_ReportError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_PARAM_ID);
-        }
-    }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_CANCEL_TRANSMIT_API_ID, CANTP_E_UNINIT);
     }
 
     return tmp_return;
 }
 
-Std_ReturnType CanTp_CancelReceive(PduIdType rxPduId)
+static CanTp_FrameStateType CanTp_LDataReqTFF(CanTp_NSduType *pNSdu)
 {
-    CanTp_NSduType *p_n_sdu;
-    CanTp_TaskStateType task_state;
-    PduLengthType n_ae_field_size;
-    Std_ReturnType tmp_return = E_NOT_OK;
+    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_FF_TX_REQUEST;
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    PduInfoType *p_pdu_info = &p_n_sdu->tx->can_if_pdu_info;
+    PduLengthType ofs = 0x00u;
 
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
-    {
-        if ((CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK) &&
-            ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
-        {
-            (void)CanTp_DecodeNAIValue(p_n_sdu->rx.cfg->af, &n_ae_field_size);
-            CANTP_ENTER_CRITICAL_SECTION
-            task_state = p_n_sdu->rx.shared.taskState;
-            CANTP_EXIT_CRITICAL_SECTION
+    p_pdu_info->SduDataPtr = &p_n_sdu->tx->buf.can[0x00u];
 
-            if (task_state == CANTP_PROCESSING)
-            {
-                /* SWS_CanTp_00262: The CanTp shall reject the request for receive cancellation in case
-                 * of a Single Frame reception or if the CanTp is in the process of receiving the last
-                 * Consecutive Frame of the N-SDU (i.e. the service is called after N-Cr timeout is
-                 * started for the last Consecutive Frame). In this case the CanTp shall return
-                 * E_NOT_OK. */
-                if (p_n_sdu->rx.buf.size > ((CANTP_CAN_FRAME_SIZE - CANTP_CF_PCI_FIELD_SIZE) + n_ae_field_size))
-                {
-                    CANTP_ENTER_CRITICAL_SECTION
-                    p_n_sdu->rx.shared.taskState = CANTP_WAIT;
-                    CANTP_EXIT_CRITICAL_SECTION
+    if (p_n_sdu->tx->geometry.n_ai_valid == TRUE)
+    {
+        p_pdu_info->SduDataPtr[0x00u] = p_n_sdu->tx->geometry.n_ai;
+        ofs = CanTp_GetNAiSize(&p_n_sdu->tx->geometry);
 
-                    /* SWS_CanTp_00263: if the CanTp_CancelReceive service has been successfully
-                     * executed the CanTp shall call the PduR_CanTpRxIndication with notification
-                     * result E_NOT_OK. */
-                    PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+        p_n_sdu->tx->sn = 0x00u;
 
-                    tmp_return = E_OK;
-                }
-            }
-            else
-            {
-                /* SWS_CanTp_00260: If the parameter value indicates a cancel reception request for an
-                 * N-SDU that it is not on reception process the CanTp module shall report the runtime
-                 * error code CANTP_E_OPER_NOT_SUPPORTED to the Default Error Tracer and the service
-                 * shall return E_NOT_OK. */
-                CanTp_ReportRuntimeError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_OPER_NOT_SUPPORTED);
-            }
+        if (pNSdu->tx->buf.size <= CANTP_FF_DL_12BIT_MAX)
+        {
+            p_pdu_info->SduDataPtr[ofs] = (uint8)(CANTP_N_PCI_TYPE_FF << 0x04u) |
+                (uint8)((uint8)(pNSdu->tx->buf.size  >> (uint8)0x08u) & (uint8)0x0Fu);
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)pNSdu->tx->buf.size & 0xFFu;
+            ofs ++;
         }
         else
         {
-            /* SWS_CanTp_00260: if development error detection is enabled the function
-             * CanTp_CancelReceive shall check the validity of RxPduId parameter. if the parameter value
-             * is invalid, the CanTp_CancelReceive function shall raise the development error
-             * CANTP_E_PARAM_ID and return E_NOT_OK (see SWS_CanTp_00294). */
-            CanTp_ReportError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_PARAM_ID);
+            /* FF_DL escape sequence: the 12 bits FF_DL is set to zero and the FF_DL is encoded on
+             * the 32 bits following it (most significant byte first). */
+            p_pdu_info->SduDataPtr[ofs] = (uint8)(CANTP_N_PCI_TYPE_FF << 0x04u);
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = 0x00u;
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)((uint32)pNSdu->tx->buf.size >> 0x18u);
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)((uint32)pNSdu->tx->buf.size >> 0x10u);
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)((uint32)pNSdu->tx->buf.size >> 0x08u);
+            ofs ++;
+            p_pdu_info->SduDataPtr[ofs] = (uint8)pNSdu->tx->buf.size & 0xFFu;
+            ofs ++;
+        }
+
+        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
+        {
+            tmp_return = CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION;
+
+            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
+             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
+             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
+             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
+             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
+             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298). */
+            if (CanTp_GetPaddingActivation(p_n_sdu->tx->cfg->padding) == CANTP_ON)
+            {
+                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CANTP_CONFIG_PTR->paddingByte);
+            }
+
+            p_pdu_info->SduLength = ofs;
         }
-    }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_CANCEL_RECEIVE_API_ID, CANTP_E_UNINIT);
     }
 
     return tmp_return;
 }
 
-#if (CANTP_CHANGE_PARAMETER_API == STD_ON)
-
-Std_ReturnType CanTp_ChangeParameter(PduIdType pduId, TPParameterType parameter, uint16 value)
+static CanTp_FrameStateType CanTp_LDataReqTCF(CanTp_NSduType *pNSdu)
 {
-    CanTp_NSduType *p_n_sdu;
-    CanTp_TaskStateType task_state;
-    Std_ReturnType tmp_return = E_NOT_OK;
-
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
-    {
-
-        if (CanTp_GetNSduFromPduId(pduId, &p_n_sdu) == E_OK)
-        {
-            CANTP_ENTER_CRITICAL_SECTION
-            task_state = p_n_sdu->rx.shared.taskState;
-            CANTP_EXIT_CRITICAL_SECTION
+    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    PduInfoType *p_pdu_info = &p_n_sdu->tx->can_if_pdu_info;
+    PduLengthType ofs = 0x00u;
 
-            if (task_state != CANTP_PROCESSING)
-            {
-                switch (parameter)
-                {
-                    case TP_STMIN:
-                    {
-                        if ((value <= 0xFFu) && ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
-                        {
-                            CANTP_ENTER_CRITICAL_SECTION
-                            p_n_sdu->rx.shared.m_param.st_min = value;
-                            CANTP_EXIT_CRITICAL_SECTION
+    p_pdu_info->SduDataPtr = &p_n_sdu->tx->buf.can[0x00u];
 
-                            tmp_return = E_OK;
-                        }
+    if (p_n_sdu->tx->geometry.n_ai_valid == TRUE)
+    {
+        p_pdu_info->SduDataPtr[0x00u] = p_n_sdu->tx->geometry.n_ai;
+        ofs = CanTp_GetNAiSize(&p_n_sdu->tx->geometry);
 
-                        break;
-                    }
-                    case TP_BS:
-                    {
-                        if ((value <= 0xFFu) && ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u))
-                        {
-                            CANTP_ENTER_CRITICAL_SECTION
-                            p_n_sdu->rx.shared.m_param.bs = (uint8)value;
-                            CANTP_EXIT_CRITICAL_SECTION
+        p_pdu_info->SduDataPtr[ofs] = (uint8)((uint8)CANTP_N_PCI_TYPE_CF << 0x04u) | (p_n_sdu->tx->sn & 0x0Fu);
+        ofs ++;
 
-                            tmp_return = E_OK;
-                        }
+        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
+        {
+            tmp_return = CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION;
 
-                        break;
-                    }
-                    case TP_BC:
-                    default:
-                    {
-                        break;
-                    }
-                }
+            p_n_sdu->tx->sn ++;
 
-                if (tmp_return != E_OK)
-                {
-                    CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_PARAM_ID);
-                }
+            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
+             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
+             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
+             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
+             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
+             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298).
+             *
+             * SWS_CanTp_00351: if a SF or last CF N-PDU with a payload > 8 (large CAN FD frame) does
+             * not match a valid CAN FD data length, it is padded up to the next valid one. */
+            if ((CanTp_GetPaddingActivation(p_n_sdu->tx->cfg->padding) == CANTP_ON) ||
+                (ofs > CANTP_CAN_FRAME_SIZE))
+            {
+                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CANTP_CONFIG_PTR->paddingByte);
             }
-        }
-        else
-        {
-            CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_PARAM_ID);
-        }
-
-    }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_CHANGE_PARAMETER_API_ID, CANTP_E_UNINIT);
+
+            p_pdu_info->SduLength = ofs;
+        }
     }
 
     return tmp_return;
 }
 
-#endif /* #if (CANTP_CHANGE_PARAMETER_API == STD_ON) */
-
-#if (CANTP_READ_PARAMETER_API == STD_ON)
-
-Std_ReturnType CanTp_ReadParameter(PduIdType pduId, TPParameterType parameter, uint16 *pValue)
+static CanTp_FrameStateType CanTp_LDataReqRFC(CanTp_NSduType *pNSdu)
 {
-    CanTp_NSduType *p_n_sdu;
-    uint16 value;
-    Std_ReturnType tmp_return = E_NOT_OK;
+    CanTp_FrameStateType tmp_return = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    PduInfoType *p_pdu_info = &p_n_sdu->rx->can_if_pdu_info;
+    uint16_least ofs = 0x00u;
 
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+
+    if (p_n_sdu->rx->geometry.n_ai_valid == TRUE)
     {
-        if (pValue != NULL_PTR)
+        p_n_sdu->rx->buf.can[0x00u] = p_n_sdu->rx->geometry.n_ai;
+        ofs = CanTp_GetNAiSize(&p_n_sdu->rx->geometry);
+
+        if (p_n_sdu->rx->fs == CANTP_FLOW_STATUS_TYPE_WT)
         {
-            if (CanTp_GetNSduFromPduId(pduId, &p_n_sdu) == E_OK)
+            if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_BR) == TRUE)
             {
-                if ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u)
+                if (p_n_sdu->rx->wft_max != 0x00u)
                 {
-                    switch (parameter)
-                    {
-                        case TP_STMIN:
-                        {
-                            CANTP_ENTER_CRITICAL_SECTION
-                            value = (uint16)p_n_sdu->rx.shared.m_param.st_min;
-                            CANTP_EXIT_CRITICAL_SECTION
-
-                            *pValue = value;
-                            tmp_return = E_OK;
-
-                            break;
-                        }
-                        case TP_BS:
-                        {
-                            CANTP_ENTER_CRITICAL_SECTION
-                            value = (uint16)p_n_sdu->rx.shared.m_param.bs;
-                            CANTP_EXIT_CRITICAL_SECTION
-
-                            *pValue = value;
-                            tmp_return = E_OK;
+                    p_n_sdu->rx->wft_max--;
 
-                            break;
-                        }
-                        case TP_BC:
-                        default:
-                        {
-                            CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+                    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
 
-                            break;
-                        }
+                    if (p_n_sdu->rx->buf.rmng < CanTp_GetRxBlockSize(p_n_sdu))
+                    {
+                        /* SWS_CanTp_00341: If the N_Br timer expires and the available buffer size
+                         * is still not big enough, the CanTp module shall send a new FC(WAIT) to
+                         * suspend the N-SDU reception and reload the N_Br timer. */
+                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
                     }
+
+                    tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
+                }
+                else
+                {
+                    /* SWS_CanTp_00223: The CanTp module shall send a maximum of WFTmax consecutive
+                     * FC(WAIT) N-PDU. If this number is reached, the CanTp module shall abort the
+                     * reception of this N-SDU (the receiver did not send any FC N-PDU, so the N_Bs
+                     * timer expires on the sender side and then the transmission is aborted) and a
+                     * receiving indication with E_NOT_OK occurs. */
+                    tmp_return = CANTP_FRAME_STATE_ABORT;
                 }
             }
             else
             {
-                CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_ID);
+                if (p_n_sdu->rx->buf.rmng >= CanTp_GetRxBlockSize(p_n_sdu))
+                {
+                    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+                    p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_CTS;
+
+                    tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
+                }
             }
         }
+        else if (p_n_sdu->rx->fs == CANTP_FLOW_STATUS_TYPE_OVFLW)
+        {
+            tmp_return = CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION;
+        }
         else
         {
-            CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_PARAM_POINTER);
+            /* the buffer is large enough for the next block: N_Br ends with the FC(CTS). */
+            CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+
+            tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
         }
-    }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_READ_PARAMETER_API_ID, CANTP_E_UNINIT);
+
+        p_n_sdu->rx->buf.can[ofs] = (0x03u << 0x04u) | (uint8)p_n_sdu->rx->fs;
+        ofs ++;
+        p_n_sdu->rx->buf.can[ofs] = p_n_sdu->rx->cfg->bs;
+        ofs ++;
+        p_n_sdu->rx->buf.can[ofs] = CanTp_EncodeSTMinValue(p_n_sdu->m_param.st_min);
+        ofs ++;
+
+        /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
+         * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
+         * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx N-PDU
+         * that belongs to that Tx N-SDU with the length of eight bytes(i.e. PduInfoPtr.SduLength =
+         * 8). Unused bytes in N-PDU shall be updated with CANTP_PADDING_BYTE (see
+         * ECUC_CanTp_00298). */
+        if (CanTp_GetPaddingActivation(p_n_sdu->rx->cfg->padding) == CANTP_ON)
+        {
+            CanTp_SetPadding(&p_n_sdu->rx->buf.can[0x00u], &ofs, CANTP_CONFIG_PTR->paddingByte);
+        }
+
+        p_pdu_info->SduDataPtr = &p_n_sdu->rx->buf.can[0x00u];
+        p_pdu_info->MetaDataPtr = CanTp_GetTxMetaData(p_n_sdu);
+        p_pdu_info->SduLength = ofs;
     }
 
     return tmp_return;
 }
 
-#endif /* #if (CANTP_READ_PARAMETER_API == STD_ON) */
+static CanTp_FrameStateType
+CanTp_LDataIndRSF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+{
+    PduLengthType dl;
+    PduLengthType header_size;
+    BufReq_ReturnType status;
+    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
-/** @} */
+    if (p_n_sdu->rx_shared.taskState == CANTP_PROCESSING)
+    {
+        /* SWS_CanTp_00057: Terminate the current reception, report an indication, with parameter
+         * Result set to E_NOT_OK, to the upper layer, and process the SF/FF N-PDU as the start of a
+         * new reception */
+        PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
 
+        CanTp_ReportRuntimeError(CANTP_I_RX_SF, CANTP_RX_INDICATION_API_ID, CANTP_E_UNEXP_PDU);
+    }
+    else
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+        p_n_sdu->rx_shared.taskState = CANTP_PROCESSING;
+        CANTP_EXIT_CRITICAL_SECTION
 
-/*-----------------------------------------------------------------------------------------------*/
-/* global scheduled function definitions.                                                        */
-/*-----------------------------------------------------------------------------------------------*/
+        CanTp_ActivateNSdu(p_n_sdu);
+    }
 
-/**
- * @addtogroup CANTP_C_GSFDEF
- * @{
- */
+    p_n_sdu->rx->retry = FALSE;
 
-void CanTp_MainFunction(void)
-{
-    uint32_least channel_idx;
-    uint32_least n_sdu_idx;
-    CanTp_NSduType *p_n_sdu;
+    /* SWS_CanTp_00345: If frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD frames)
+     * are used for a Rx N-SDU and CanTpRxPaddingActivation is equal to CANTP_ON, then CanTp
+     * receives by means of CanTp_RxIndication() call an SF Rx N-PDU belonging to that N-SDU, with a
+     * length smaller than eight bytes (i.e. PduInfoPtr.SduLength < 8), CanTp shall reject the
+     * reception. The runtime error code CANTP_E_PADDING shall be reported to the Default Error
+     * Tracer. */
+    if (((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) == 0x00u) &&
+        (pPduInfo->SduLength > CANTP_CAN_FRAME_SIZE))
+    {
+        /* SF_DL escape sequence (CAN FD frame larger than 8 bytes): the SF_DL is stored in the byte
+         * following the N_PCI byte. */
+        header_size = CANTP_SF_ESC_PCI_FIELD_SIZE + nAeSize;
+        dl = (PduLengthType)pPduInfo->SduDataPtr[nAeSize + 0x01u];
+    }
+    else
+    {
+        header_size = CANTP_SF_PCI_FIELD_SIZE + nAeSize;
 
-    CanTp_TaskStateType task_state_rx;
-    CanTp_TaskStateType task_state_tx;
+        dl = CanTp_DecodeDLValue(CANTP_N_PCI_TYPE_SF,
+                                 CanTp_GetPaddingActivation(p_n_sdu->rx->cfg->padding),
+                                 &pPduInfo->SduDataPtr[nAeSize]);
+    }
 
-    if ((CanTp_StateType)CanTp_State == (CanTp_StateType)CANTP_ON)
+    p_n_sdu->rx->buf.size = dl;
+    p_n_sdu->rx->dst.p_data = NULL_PTR;
+    p_n_sdu->rx->staging.cnt = 0x00u;
+
+    p_n_sdu->rx->pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
+    p_n_sdu->rx->pdu_r_pdu_info.SduLength = dl;
+    p_n_sdu->rx->pdu_r_pdu_info.MetaDataPtr = CanTp_GetRxMetaData(p_n_sdu);
+
+    status = PduR_CanTpStartOfReception(p_n_sdu->rx->cfg->nSduId,
+                                        &p_n_sdu->rx->pdu_r_pdu_info,
+                                        dl,
+                                        &p_n_sdu->rx->buf.rmng);
+    if (status == BUFREQ_OK)
     {
-        for (channel_idx = 0x00u; channel_idx < (uint32_least)CANTP_MAX_NUM_OF_CHANNEL; channel_idx++)
+        /* SWS_CanTp_00339: After the reception of a First Frame or Single Frame, if the
+         * function PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
+         * buffer size than needed for the already received data, the CanTp module shall
+         * abort the reception of the N-SDU and call PduR_CanTpRxIndication() with the
+         * result E_NOT_OK. */
+        if (p_n_sdu->rx->buf.rmng < dl)
         {
-            for (n_sdu_idx = 0x00u; n_sdu_idx < (uint32_least)CANTP_MAX_NUM_OF_N_SDU; n_sdu_idx++)
-            {
-                p_n_sdu = &CanTp_Rt[channel_idx].sdu[n_sdu_idx];
-
-                CANTP_ENTER_CRITICAL_SECTION
-                task_state_rx = p_n_sdu->rx.shared.taskState;
-                CANTP_EXIT_CRITICAL_SECTION
+            PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
 
-                task_state_tx = p_n_sdu->tx.taskState;
+            /* TODO:return STATE_OK? */
+            result = CANTP_FRAME_STATE_ABORT;
+        }
+        else
+        {
+            status = CanTp_CopyRxPayload(p_n_sdu);
 
-                if (task_state_rx == CANTP_PROCESSING)
-                {
-                    CanTp_PerformStepRx(p_n_sdu);
-                }
+            if (status == BUFREQ_OK)
+            {
+                status = CanTp_FlushRxPayload(p_n_sdu);
+            }
 
-                if (task_state_tx == CANTP_PROCESSING)
-                {
-                    CanTp_PerformStepTx(p_n_sdu);
-                }
+            if (status == BUFREQ_OK)
+            {
+                result = CANTP_FRAME_STATE_OK;
+                PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_OK);
+            }
+            else
+            {
+                /* TODO: handle other return values. */
 
-                CANTP_ENTER_CRITICAL_SECTION
-                p_n_sdu->n[0x00u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->n[0x01u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->n[0x02u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->n[0x03u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->n[0x04u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->n[0x05u] += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->rx.st_min += CanTp_ConfigPtr->mainFunctionPeriod;
-                p_n_sdu->tx.st_min += CanTp_ConfigPtr->mainFunctionPeriod;
-                CANTP_EXIT_CRITICAL_SECTION
+                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
+                 * reception of a Consecutive Frame in a block the CanTp shall abort the
+                 * reception of N-SDU and notify the PduR module by calling the
+                 * PduR_CanTpRxIndication() with the result E_NOT_OK. */
+                result = CANTP_FRAME_STATE_ABORT;
+                PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
             }
         }
     }
+    else if ((status == BUFREQ_E_BUSY) || (status == BUFREQ_E_NOT_OK))
+    {
+        /* SWS_CanTp_00081: ⌈After the reception of a First Frame or Single Frame, if the
+         * function PduR_CanTpStartOfReception()returns BUFREQ_E_NOT_OK to the CanTp module, the
+         * CanTp module shall abort the reception of this N-SDU. No Flow Control will be sent
+         * and PduR_CanTpRxIndication() will not be called in this case. */
+        result = CANTP_FRAME_STATE_ABORT;
+    }
+    else if (status == BUFREQ_E_OVFL)
+    {
+        /* SWS_CanTp_00353: After the reception of a Single Frame, if the function
+         * PduR_CanTpStartOfReception()returns BUFREQ_E_OVFL to the CanTp module, the CanTp
+         * module shall abort the N-SDU reception. */
+        result = CANTP_FRAME_STATE_ABORT;
+    }
     else
     {
-        CanTp_ReportError(0x00u, CANTP_MAIN_FUNCTION_API_ID, CANTP_E_UNINIT);
+        /* MISRA C, do nothing. */
     }
+
+    return result;
 }
 
-/** @} */
+static CanTp_FrameStateType
+CanTp_LDataIndRFF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+{
+    PduLengthType header_size;
+    PduLengthType payload_size;
+    BufReq_ReturnType status;
+    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
+    if (p_n_sdu->rx_shared.taskState == CANTP_PROCESSING)
+    {
+        /* SWS_CanTp_00057: Terminate the current reception, report an indication, with parameter
+         * Result set to E_NOT_OK, to the upper layer, and process the SF/FF N-PDU as the start of a
+         * new reception */
+        PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
 
-/*-----------------------------------------------------------------------------------------------*/
-/* global callback function definitions.                                                         */
-/*-----------------------------------------------------------------------------------------------*/
+        CanTp_ReportRuntimeError(CANTP_I_RX_FF, CANTP_RX_INDICATION_API_ID, CANTP_E_UNEXP_PDU);
+    }
+    else
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+        p_n_sdu->rx_shared.taskState = CANTP_PROCESSING;
+        CANTP_EXIT_CRITICAL_SECTION
 
-/**
- * @addtogroup CANTP_C_GCFDEF
- * @{
- */
+        CanTp_ActivateNSdu(p_n_sdu);
+    }
 
-static void CanTp_StartNetworkLayerTimeout(CanTp_NSduType *pNSdu, const uint8 instanceId)
-{
-    if ((pNSdu->t_flag & ((uint32)0x01u << instanceId)) == 0x00u)
+    p_n_sdu->rx->retry = FALSE;
+
+    /* SWS_CanTp_00350: The received data link layer data length (RX_DL) shall be derived from the
+     * first received payload length of the CAN frame/PDU (CAN_DL) as follows:
+     * - For CAN_DL values less than or equal to eight bytes the RX_DL value shall be eight.
+     * - For CAN_DL values greater than eight bytes the RX_DL value equals the CAN_DL value. */
+    if (pPduInfo->SduLength > CANTP_CAN_FRAME_SIZE)
     {
-        pNSdu->t_flag |= ((uint32)0x01u << instanceId);
-        pNSdu->n[instanceId] = 0x00u;
+        p_n_sdu->rx->dl = (uint8)pPduInfo->SduLength;
+    }
+    else
+    {
+        p_n_sdu->rx->dl = CANTP_CAN_FRAME_SIZE;
     }
-}
 
-static void CanTp_StopNetworkLayerTimeout(CanTp_NSduType *pNSdu, const uint8 instanceId)
-{
-    pNSdu->t_flag &= ~((uint32)0x01u << instanceId);
-}
+    p_n_sdu->rx->buf.size = CanTp_DecodeDLValue(CANTP_N_PCI_TYPE_FF,
+                                               CanTp_GetPaddingActivation(p_n_sdu->rx->cfg->padding),
+                                               &pPduInfo->SduDataPtr[nAeSize]);
 
-static boolean CanTp_NetworkLayerTimeoutExpired(const CanTp_NSduType *pNSdu, const uint8 instanceId)
-{
-    boolean result = FALSE;
+    if (((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) == 0x00u) &&
+        (pPduInfo->SduDataPtr[nAeSize + 0x01u] == 0x00u))
+    {
+        /* FF_DL escape sequence (FF_DL > 4095): the FF_DL is encoded on the 32 bits following the
+         * 12 bits FF_DL field (most significant byte first). */
+        header_size = CANTP_FF_ESC_PCI_FIELD_SIZE + nAeSize;
+        p_n_sdu->rx->buf.size = (PduLengthType)(((uint32)pPduInfo->SduDataPtr[nAeSize + 0x02u] << 0x18u) |
+                                               ((uint32)pPduInfo->SduDataPtr[nAeSize + 0x03u] << 0x10u) |
+                                               ((uint32)pPduInfo->SduDataPtr[nAeSize + 0x04u] << 0x08u) |
+                                               (uint32)pPduInfo->SduDataPtr[nAeSize + 0x05u]);
+    }
+    else
+    {
+        header_size = CANTP_FF_PCI_FIELD_SIZE + nAeSize;
+    }
+
+    payload_size = p_n_sdu->rx->dl - header_size;
+    p_n_sdu->rx->geometry.cf_dl = p_n_sdu->rx->dl - (CANTP_CF_PCI_FIELD_SIZE + nAeSize);
+
+    p_n_sdu->rx->sn = 0x00u;
+    p_n_sdu->rx->dst.p_data = NULL_PTR;
+    p_n_sdu->rx->staging.cnt = 0x00u;
+    p_n_sdu->rx->wft_max = p_n_sdu->rx->cfg->wftMax;
+    p_n_sdu->rx->bs = p_n_sdu->m_param.bs;
+
+    /* the FF holds its whole N_PCI and its FF_DL exceeds its payload, both are checked by
+     * CanTp_CheckRxDLValue. */
+    p_n_sdu->rx->pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
+    p_n_sdu->rx->pdu_r_pdu_info.SduLength = pPduInfo->SduLength - header_size;
+    p_n_sdu->rx->pdu_r_pdu_info.MetaDataPtr = CanTp_GetRxMetaData(p_n_sdu);
+
+    /* TODO: as I understand, the N_Br is the time allowed for the upper layer to provide the
+     *  required buffer. thus, the N_Br timeout will be handled according to SWS_CanTp_00082. */
+
+    /* SWS_CanTp_00166: At the reception of a FF or last CF of a block, the CanTp module shall start
+     * a time-out N_Br before calling PduR_CanTpStartOfReception or PduR_CanTpCopyRxData.
+     *
+     * CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR); */
 
-    if (instanceId == CANTP_I_N_AS)
-    {
-        if ((pNSdu->n[CANTP_I_N_AS] >= pNSdu->tx.cfg->nas) &&
-            ((pNSdu->t_flag & ((uint32)0x01u /* << CANTP_I_N_AS */)) != 0x00u))
-        {
-            result = TRUE;
-        }
-    }
-    else if (instanceId == CANTP_I_N_BS)
-    {
-        if ((pNSdu->n[CANTP_I_N_BS] >= pNSdu->tx.cfg->nbs) &&
-            ((pNSdu->t_flag & ((uint32)0x01u << CANTP_I_N_BS)) != 0x00u))
-        {
-            result = TRUE;
-        }
-    }
-    else if (instanceId == CANTP_I_N_CS)
+    status = PduR_CanTpStartOfReception(p_n_sdu->rx->cfg->nSduId,
+                                        &p_n_sdu->rx->pdu_r_pdu_info,
+                                        p_n_sdu->rx->buf.size,
+                                        &p_n_sdu->rx->buf.rmng);
+    if (status == BUFREQ_OK)
     {
-        if ((pNSdu->n[CANTP_I_N_CS] >= pNSdu->tx.cfg->ncs) &&
-            ((pNSdu->t_flag & ((uint32)0x01u << CANTP_I_N_CS)) != 0x00u))
+        /* SWS_CanTp_00339: After the reception of a First Frame or Single Frame, if the
+         * function PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
+         * buffer size than needed for the already received data, the CanTp module shall abort
+         * the reception of the N-SDU and call PduR_CanTpRxIndication() with the result
+         * E_NOT_OK. */
+        if (p_n_sdu->rx->buf.rmng < payload_size)
         {
-            result = TRUE;
+            PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+
+            result = CANTP_FRAME_STATE_ABORT;
         }
-    }
-    else if (instanceId == CANTP_I_N_AR)
-    {
-        if ((pNSdu->n[CANTP_I_N_AR] >= pNSdu->rx.cfg->nar) &&
-            ((pNSdu->t_flag & ((uint32)0x01u << CANTP_I_N_AR)) != 0x00u))
+        else
         {
-            result = TRUE;
+            result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+
+            if (p_n_sdu->rx->buf.rmng < CanTp_GetRxBlockSize(p_n_sdu))
+            {
+                /* SWS_CanTp_00082: After the reception of a First Frame, if the function
+                 * PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
+                 * buffer size than needed for the next block, the CanTp module shall start the
+                 * timer N_Br. */
+                CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+
+                p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_WT;
+            }
+            else
+            {
+                p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_CTS;
+            }
+
+            if (CanTp_CopyRxPayload(p_n_sdu) != BUFREQ_OK)
+            {
+                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
+                 * reception of a Consecutive Frame in a block the CanTp shall abort the
+                 * reception of N-SDU and notify the PduR module by calling the
+                 * PduR_CanTpRxIndication() with the result E_NOT_OK. */
+                result = CANTP_FRAME_STATE_ABORT;
+                PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+            }
+            else
+            {
+                /* TODO: handle other return values. */
+            }
         }
     }
-    else if (instanceId == CANTP_I_N_BR)
+    else if ((status == BUFREQ_E_BUSY) || (status == BUFREQ_E_NOT_OK))
     {
-        if ((pNSdu->n[CANTP_I_N_BR] >= pNSdu->rx.cfg->nbr) &&
-            ((pNSdu->t_flag & ((uint32)0x01u << CANTP_I_N_BR)) != 0x00u))
-        {
-            result = TRUE;
-        }
+        /* SWS_CanTp_00081: After the reception of a First Frame or Single Frame, if the
+         * function PduR_CanTpStartOfReception()returns BUFREQ_E_NOT_OK to the CanTp module,
+         * the CanTp module shall abort the reception of this N-SDU. No Flow Control will be
+         * sent and PduR_CanTpRxIndication() will not be called in this case. */
+        result = CANTP_FRAME_STATE_ABORT;
     }
-    else if (instanceId == CANTP_I_N_CR)
+    else if (status == BUFREQ_E_OVFL)
     {
-        if ((pNSdu->n[CANTP_I_N_CR] >= pNSdu->rx.cfg->ncr) &&
-            ((pNSdu->t_flag & ((uint32)0x01u << CANTP_I_N_CR)) != 0x00u))
-        {
-            result = TRUE;
-        }
+        /* SWS_CanTp_00318: After the reception of a First Frame, if the function
+         * PduR_CanTpStartOfReception() returns BUFREQ_E_OVFL to the CanTp module, the CanTp
+         * module shall send a Flow Control N-PDU with overflow status (FC(OVFLW)) and abort the
+         * N-SDU reception. */
+        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+        p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_OVFLW;
     }
     else
     {
@@ -1226,941 +3403,1326 @@ static boolean CanTp_NetworkLayerTimeoutExpired(const CanTp_NSduType *pNSdu, con
     return result;
 }
 
-static boolean CanTp_NetworkLayerIsActive(const CanTp_NSduType *pNSdu, const uint8 instanceId)
+static CanTp_FrameStateType
+CanTp_LDataIndRCF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
 {
-    boolean result;
+    PduLengthType header_size;
+    BufReq_ReturnType status;
+    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
-    if ((pNSdu->t_flag & ((uint32)0x01u << instanceId)) == 0x00u)
-    {
-        result = FALSE;
-    }
-    else
+    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
+
+    if (p_n_sdu->rx_shared.taskState == CANTP_PROCESSING)
     {
-        result = TRUE;
+        header_size = CANTP_CF_PCI_FIELD_SIZE + nAeSize;
+
+        /* ISO 15765-2: the CAN_DL of each CF is the RX_DL derived from the FF, only the last CF may
+         * be shorter as long as it carries the remaining bytes of the N-SDU. the reception is
+         * aborted on any other CAN_DL. */
+        if ((pPduInfo->SduLength > p_n_sdu->rx->dl) ||
+            ((pPduInfo->SduLength < p_n_sdu->rx->dl) &&
+             (pPduInfo->SduLength < (header_size + p_n_sdu->rx->buf.size))))
+        {
+            result = CANTP_FRAME_STATE_ABORT;
+            PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+        }
+        else if ((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) == ((p_n_sdu->rx->sn + 0x01u) & 0x0Fu))
+        {
+
+            p_n_sdu->rx->sn++;
+            p_n_sdu->rx->bs--;
+
+            p_n_sdu->rx->pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
+            p_n_sdu->rx->pdu_r_pdu_info.SduLength = pPduInfo->SduLength - header_size;
+            p_n_sdu->rx->pdu_r_pdu_info.MetaDataPtr = CanTp_GetRxMetaData(p_n_sdu);
+
+            /* the last CF may carry padding bytes (up to eight bytes or up to the next valid CAN
+             * FD data length), only the remaining bytes of the N-SDU are copied. */
+            if (p_n_sdu->rx->pdu_r_pdu_info.SduLength > p_n_sdu->rx->buf.size)
+            {
+                p_n_sdu->rx->pdu_r_pdu_info.SduLength = p_n_sdu->rx->buf.size;
+            }
+
+            status = CanTp_CopyRxPayload(p_n_sdu);
+
+            /* if a staging buffer is configured, the upper layer is only notified at the end of each
+             * block and at the end of the reception. */
+            if ((status == BUFREQ_OK) &&
+                ((p_n_sdu->rx->buf.size == 0x00u) || (p_n_sdu->rx->bs == 0x00u)))
+            {
+                status = CanTp_FlushRxPayload(p_n_sdu);
+            }
+
+            if (status == BUFREQ_OK)
+            {
+                if (p_n_sdu->rx->buf.size != 0x00u)
+                {
+                    if (p_n_sdu->rx->bs == 0x00u)
+                    {
+                        p_n_sdu->rx->bs = p_n_sdu->m_param.bs;
+
+                        /* SWS_CanTp_00166: At the reception of a FF or last CF of a block, the CanTp
+                         * module shall start a time-out N_Br before calling PduR_CanTpStartOfReception
+                         * or PduR_CanTpCopyRxData. */
+                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+                        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+
+                        /* SWS_CanTp_00222: the FC(CTS) of the next block is only sent if the
+                         * upper layer buffer is large enough, otherwise FC(WAIT) is sent. */
+                        if (p_n_sdu->rx->buf.rmng < CanTp_GetRxBlockSize(p_n_sdu))
+                        {
+                            p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_WT;
+                        }
+                        else
+                        {
+                            p_n_sdu->rx->fs = CANTP_FLOW_STATUS_TYPE_CTS;
+                        }
+                    }
+                    else
+                    {
+                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
+                        result = CANTP_RX_FRAME_STATE_CF_RX_INDICATION;
+                    }
+                }
+                else
+                {
+                    PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_OK);
+                    result = CANTP_FRAME_STATE_OK;
+                }
+            }
+            else
+            {
+                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
+                 * reception of a Consecutive Frame in a block the CanTp shall abort the reception
+                 * of N-SDU and notify the PduR module by calling the PduR_CanTpRxIndication() with
+                 * the result E_NOT_OK. */
+                PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+                result = CANTP_FRAME_STATE_ABORT;
+            }
+        }
+        else
+        {
+            /* SWS_CanTp_00314: The CanTp shall check the correctness of each SN received during a
+             * segmented reception. In case of wrong SN received the CanTp module shall abort
+             * reception and notify the upper layer of this failure by calling the indication
+             * function PduR_CanTpRxIndication() with the result E_NOT_OK. */
+            result = CANTP_FRAME_STATE_ABORT;
+            PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+        }
     }
 
     return result;
 }
 
-static void CanTp_StartFlowControlTimeout(CanTp_NSduType *pNSdu)
+static CanTp_FrameStateType
+CanTp_LDataIndTFC(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
 {
-    if ((pNSdu->tx.shared.flag & CANTP_I_ST_MIN) == 0x00u)
-    {
-        pNSdu->tx.shared.flag |= CANTP_I_ST_MIN;
-        pNSdu->tx.st_min = 0x00u;
-    }
-}
+    CanTp_FrameStateType result;
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
-static boolean CanTp_FlowControlActive(const CanTp_NSduType *pNSdu)
-{
-    boolean result = FALSE;
+    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
 
-    if ((pNSdu->tx.shared.flag & CANTP_I_ST_MIN) != 0x00u)
+    /* SWS_CanTp_00349: if CanTpTxPaddingActivation is equal to CANTP_ON for a Tx N-SDU, and if a FC
+     * N-PDU is received for that Tx N-SDU on a ongoing transmission, by means of
+     * CanTp_RxIndication() call, and the length of this FC is smaller than eight bytes (i.e.
+     * PduInfoPtr.SduLength <8) the CanTp module shall abort the transmission session by calling
+     * PduR_CanTpTxConfirmation() with the result E_NOT_OK. The runtime error code CANTP_E_PADDING
+     * shall be reported to the Default Error Tracer. */
+    if (!((CanTp_GetPaddingActivation(pNSdu->tx->cfg->padding) == CANTP_ON) &&
+          (pPduInfo->SduLength < CANTP_CAN_FRAME_SIZE)))
     {
-        result = TRUE;
-    }
+        p_n_sdu->tx->fs = (CanTp_FlowStatusType)pPduInfo->SduDataPtr[nAeSize] & 0x0Fu;
+        p_n_sdu->tx->bs = pPduInfo->SduDataPtr[nAeSize + 0x01u];
+        p_n_sdu->tx->target_st_min = CanTp_DecodeSTMinValue(pPduInfo->SduDataPtr[nAeSize + 0x02u]);
 
-    return result;
-}
+        /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
+         * confirmation of the FF transmission, last CF of a block transmission and at each
+         * indication of FC with FS=WT (i.e. time until reception of the next FC). */
+        if (p_n_sdu->tx->fs == CANTP_FLOW_STATUS_TYPE_WT)
+        {
+            CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
+        }
 
-static boolean CanTp_FlowControlExpired(CanTp_NSduType *pNSdu)
-{
-    boolean result = FALSE;
+        /* ISO15765:
+         * 00: The BS parameter value zero (0) shall be used to indicate to the sender that no more
+         * FC frames shall be sent during the transmission of the segmented message. The sending
+         * network layer entity shall send all remaining consecutive frames without any stop for
+         * further FC frames from the receiving network layer entity.
+         * 01-FF: This range of BS parameter values shall be used to indicate to the sender the
+         * maximum number of consecutive frames that can be received without an intermediate FC
+         * frame from the receiving network entity.*/
+        if (p_n_sdu->tx->bs == 0x00u)
+        {
+            p_n_sdu->tx->bs = CANTP_BS_INFINITE;
+        }
 
-    if ((pNSdu->tx.st_min >= pNSdu->tx.target_st_min) &&
-        ((pNSdu->tx.shared.flag & CANTP_I_ST_MIN) != 0x00u))
+        result = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+    }
+    else
     {
-        result = TRUE;
-        pNSdu->tx.shared.flag &= ~(CANTP_I_ST_MIN);
+        PduR_CanTpTxConfirmation(p_n_sdu->tx->cfg->nSduId, E_NOT_OK);
+        CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_PADDING);
+
+        result = CANTP_FRAME_STATE_ABORT;
     }
 
     return result;
 }
 
-static CanTp_FrameStateType CanTp_LDataReqTSF(CanTp_NSduType *pNSdu)
+static CanTp_FrameStateType CanTp_LDataConTSF(CanTp_NSduType *pNSdu)
 {
-    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_SF_TX_REQUEST;
     CanTp_NSduType *p_n_sdu = pNSdu;
-    PduInfoType *p_pdu_info = &p_n_sdu->tx.can_if_pdu_info;
-    PduLengthType ofs = 0x00u;
 
-    p_pdu_info->SduDataPtr = &p_n_sdu->tx.buf.can[0x00u];
+    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AS);
 
-    if (CanTp_EncodeNAIValue(p_n_sdu->tx.cfg->af,
-                             p_n_sdu->tx.cfg->pNAe,
-                             p_n_sdu->tx.cfg->pNTa,
-                             &p_pdu_info->SduDataPtr[ofs],
-                             &ofs) == E_OK)
-    {
-        /* prevent lint issue by providing zero valued rhs argument to operators '<<' and '|'. */
-        p_pdu_info->SduDataPtr[ofs] = /* (uint8)((uint8)CANTP_N_PCI_TYPE_SF << 0x04u) | */
-            (uint8)pNSdu->tx.buf.size;
-        ofs = ofs + 0x01u;
+    return CANTP_FRAME_STATE_OK;
+}
 
-        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
-        {
-            tmp_return = CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION;
+static CanTp_FrameStateType CanTp_LDataConTFF(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
-            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
-             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
-             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
-             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
-             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
-             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298). */
-            if (p_n_sdu->tx.cfg->padding == CANTP_ON)
-            {
-                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CanTp_ConfigPtr->paddingByte);
-            }
+    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AS);
 
-            p_pdu_info->SduLength = ofs;
-        }
-    }
+    /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
+     * confirmation of the FF transmission, last CF of a block transmission and at each indication
+     * of FC with FS=WT (i.e. time until reception of the next FC). */
+    CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
 
-    return tmp_return;
+    return CANTP_TX_FRAME_STATE_FC_RX_INDICATION;
 }
 
-static CanTp_FrameStateType CanTp_LDataReqTFF(CanTp_NSduType *pNSdu)
+static CanTp_FrameStateType CanTp_LDataConTCF(CanTp_NSduType *pNSdu)
 {
-    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_FF_TX_REQUEST;
+    CanTp_FrameStateType result;
     CanTp_NSduType *p_n_sdu = pNSdu;
-    PduInfoType *p_pdu_info = &p_n_sdu->tx.can_if_pdu_info;
-    PduLengthType ofs = 0x00u;
-
-    p_pdu_info->SduDataPtr = &p_n_sdu->tx.buf.can[0x00u];
 
-    if (CanTp_EncodeNAIValue(p_n_sdu->tx.cfg->af,
-                             p_n_sdu->tx.cfg->pNAe,
-                             p_n_sdu->tx.cfg->pNTa,
-                             &p_pdu_info->SduDataPtr[ofs],
-                             &ofs) == E_OK)
-    {
-        p_n_sdu->tx.sn = 0x00u;
+    CanTp_ReleaseTxCF(p_n_sdu);
 
-        p_pdu_info->SduDataPtr[ofs] = (uint8)(CANTP_N_PCI_TYPE_FF << 0x04u) |
-            (uint8)((uint8)(pNSdu->tx.buf.size  >> (uint8)0x08u) & (uint8)0x0Fu);
-        ofs ++;
-        p_pdu_info->SduDataPtr[ofs] = (uint8)pNSdu->tx.buf.size & 0xFFu;
-        ofs ++;
+    /* ISO15765: the measurement of the STmin starts after completion of transmission of a
+     * ConsecutiveFrame (CF) and ends at the request for the transmission of the next CF. */
+    CanTp_StartFlowControlTimeout(p_n_sdu);
 
-        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
+    if ((p_n_sdu->tx->buf.size > 0x00u) || (p_n_sdu->tx->in_flight_cnt > 0x00u))
+    {
+        if (p_n_sdu->tx->bs != CANTP_BS_INFINITE)
         {
-            tmp_return = CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION;
+            p_n_sdu->tx->bs--;
+        }
 
-            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
-             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
-             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
-             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
-             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
-             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298). */
-            if (p_n_sdu->tx.cfg->padding == CANTP_ON)
-            {
-                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CanTp_ConfigPtr->paddingByte);
-            }
+        if (p_n_sdu->tx->in_flight_cnt > 0x00u)
+        {
+            /* other CFs of the transmit window are still waiting for their confirmation. */
+            result = CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION;
+        }
+        else if (p_n_sdu->tx->bs != 0x00u)
+        {
+            result = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+        }
+        else
+        {
+            /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
+             * confirmation of the FF transmission, last CF of a block transmission and at each
+             * indication of FC with FS=WT (i.e. time until reception of the next FC). */
+            CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
 
-            p_pdu_info->SduLength = ofs;
+            result = CANTP_TX_FRAME_STATE_FC_RX_INDICATION;
         }
     }
+    else
+    {
+        result = CANTP_FRAME_STATE_OK;
+    }
 
-    return tmp_return;
+    return result;
 }
 
-static CanTp_FrameStateType CanTp_LDataReqTCF(CanTp_NSduType *pNSdu)
+static CanTp_FrameStateType CanTp_LDataConRFC(CanTp_NSduType *pNSdu)
 {
-    CanTp_FrameStateType tmp_return = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+    CanTp_FrameStateType result;
     CanTp_NSduType *p_n_sdu = pNSdu;
-    PduInfoType *p_pdu_info = &p_n_sdu->tx.can_if_pdu_info;
-    PduLengthType ofs = 0x00u;
 
-    p_pdu_info->SduDataPtr = &p_n_sdu->tx.buf.can[0x00u];
+    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AR);
+    CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
 
-    if (CanTp_EncodeNAIValue(p_n_sdu->tx.cfg->af,
-                             p_n_sdu->tx.cfg->pNAe,
-                             p_n_sdu->tx.cfg->pNTa,
-                             &p_pdu_info->SduDataPtr[ofs],
-                             &ofs) == E_OK)
+    if (CanTp_NetworkLayerIsActive(p_n_sdu, CANTP_I_N_BR) == FALSE)
     {
-        p_pdu_info->SduDataPtr[ofs] = (uint8)((uint8)CANTP_N_PCI_TYPE_CF << 0x04u) | (p_n_sdu->tx.sn & 0x0Fu);
-        ofs ++;
-
-        if (CanTp_CopyTxPayload(p_n_sdu, &ofs) == BUFREQ_OK)
-        {
-            tmp_return = CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION;
-
-            p_n_sdu->tx.sn ++;
-
-            /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
-             * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
-             * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx
-             * N-PDU that belongs to that Tx N-SDU with the length of eight bytes(i.e.
-             * PduInfoPtr.SduLength = 8). Unused bytes in N-PDU shall be updated with
-             * CANTP_PADDING_BYTE (see ECUC_CanTp_00298). */
-            if (p_n_sdu->tx.cfg->padding == CANTP_ON)
-            {
-                CanTp_SetPadding(&p_pdu_info->SduDataPtr[0x00u], &ofs, CanTp_ConfigPtr->paddingByte);
-            }
-
-            p_pdu_info->SduLength = ofs;
-        }
+        result = CANTP_RX_FRAME_STATE_CF_RX_INDICATION;
+    }
+    else
+    {
+        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
     }
 
-    return tmp_return;
+    return result;
 }
 
-static CanTp_FrameStateType CanTp_LDataReqRFC(CanTp_NSduType *pNSdu)
+void CanTp_RxIndication(PduIdType rxPduId, const PduInfoType *pPduInfo)
 {
-    CanTp_FrameStateType tmp_return = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
-    CanTp_NSduType *p_n_sdu = pNSdu;
-    PduInfoType *p_pdu_info = &p_n_sdu->rx.can_if_pdu_info;
-    uint16_least ofs = 0x00u;
-
+    CanTp_FrameStateType next_state;
+    const CanTp_StateHandlerType *p_handler;
+    CanTp_NPciType pci;
+    PduLengthType n_ae_field_size;
+    CanTp_NSduType *p_n_sdu;
 
-    if (CanTp_EncodeNAIValue(p_n_sdu->rx.cfg->af,
-                             p_n_sdu->rx.cfg->pNAe,
-                             p_n_sdu->rx.cfg->pNTa,
-                             &p_n_sdu->rx.buf.can[ofs],
-                             &ofs) == E_OK)
+    if (pPduInfo != NULL_PTR)
     {
-        if (p_n_sdu->rx.fs == CANTP_FLOW_STATUS_TYPE_WT)
+        if (CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK)
         {
-            if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_BR) == TRUE)
+            /* non-standard: the N-PDUs of a dynamically addressed N-SDU are processed by the
+             * connection pool entry bound to the peer identified by their meta data, they are
+             * ignored if no entry is available. */
+            if ((p_n_sdu->dynamic != TRUE) ||
+                (CanTp_BindPeer(&p_n_sdu, pPduInfo->MetaDataPtr, TRUE) == E_OK))
             {
-                if (p_n_sdu->rx.wft_max != 0x00u)
+                /* non-standard: a SF or FF received on an Rx N-SDU without connection binds one of
+                 * the reception connection pool. */
+                if (((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u) &&
+                    (CanTp_BindRxConnection(p_n_sdu, pPduInfo) == E_OK))
                 {
-                    p_n_sdu->rx.wft_max--;
+                    if (p_n_sdu->rx->geometry.af_valid == TRUE)
+                    {
+                        n_ae_field_size = CanTp_GetNAiSize(&p_n_sdu->rx->geometry);
 
-                    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+                        if (CanTp_DecodePCIValue(&pci, &pPduInfo->SduDataPtr[n_ae_field_size]) == E_OK)
+                        {
+                            /* N-PDUs longer than the maximum RX_DL configured for this N-SDU are ignored. */
+                            if (pPduInfo->SduLength > p_n_sdu->rx->cfg->rxDl)
+                            {
+                                next_state = CANTP_FRAME_STATE_INVALID;
+                            }
+                            /* SWS_CanTp_00345: If frames with a payload <= 8 (either CAN 2.0 frames or small
+                             * CAN FD frames) are used for a Rx N-SDU and CanTpRxPaddingActivation is equal to
+                             * CANTP_ON, then CanTp receives by means of CanTp_RxIndication() call an SF Rx
+                             * N-PDU belonging to that N-SDU, with a length smaller than eight bytes (i.e.
+                             * PduInfoPtr.SduLength < 8), CanTp shall reject the reception. The runtime error
+                             * code CANTP_E_PADDING shall be reported to the Default Error Tracer. */
+                            else if ((CanTp_GetPaddingActivation(p_n_sdu->rx->cfg->padding) == CANTP_ON) &&
+                                (pPduInfo->SduLength < CANTP_CAN_FRAME_SIZE))
+                            {
+                                PduR_CanTpRxIndication(p_n_sdu->rx->cfg->nSduId, E_NOT_OK);
+
+                                CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID,
+                                                         CANTP_E_PADDING);
+
+                                next_state = CANTP_FRAME_STATE_OK;
+                            }
+                            /* SWS_CanTp_00093: If a multiple segmented session occurs (on both receiver and
+                             * sender side) with a handle whose communication type is functional, the CanTp
+                             * module shall reject the request and report the runtime error code
+                             * CANTP_E_INVALID_TATYPE to the Default Error Tracer. */
+                            else if ((p_n_sdu->rx->cfg->taType == CANTP_FUNCTIONAL) &&
+                                     (pci == CANTP_N_PCI_TYPE_FF))
+                            {
+                                CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID,
+                                                         CANTP_E_INVALID_TATYPE);
+
+                                next_state = CANTP_FRAME_STATE_OK;
+                            }
+                            /* the SF or FF is ignored if its data length is not valid. */
+                            else if (CanTp_CheckRxDLValue(p_n_sdu, pPduInfo, n_ae_field_size, pci) != E_OK)
+                            {
+                                next_state = CANTP_FRAME_STATE_INVALID;
+                            }
+                            else if (pci == CANTP_N_PCI_TYPE_SF)
+                            {
+                                next_state = CanTp_LDataIndRSF(p_n_sdu, pPduInfo, n_ae_field_size);
+                            }
+                            else if (pci == CANTP_N_PCI_TYPE_FF)
+                            {
+                                next_state = CanTp_LDataIndRFF(p_n_sdu, pPduInfo, n_ae_field_size);
+                            }
+                            else
+                            {
+                                next_state = CANTP_FRAME_STATE_INVALID;
+                                p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_RX,
+                                                                  p_n_sdu->rx_shared.state);
+
+                                if ((p_handler->indication != NULL_PTR) && (p_handler->pci == pci))
+                                {
+                                    next_state = p_handler->indication(p_n_sdu, pPduInfo, n_ae_field_size);
+                                }
+                            }
+
+                            if (next_state != CANTP_FRAME_STATE_INVALID)
+                            {
+                                p_n_sdu->rx_shared.state = next_state;
+
+                                /* on reception of a FF or of the last CF of a block, the FC is sent
+                                 * right away instead of waiting for the next main function call (it
+                                 * is only sent if the upper layer buffer is large enough). */
+                                if ((next_state == CANTP_RX_FRAME_STATE_FC_TX_REQUEST) &&
+                                    (p_n_sdu->channel->processingMode == CANTP_IMMEDIATE_PROCESSING))
+                                {
+                                    CanTp_PerformStepRxFC(p_n_sdu);
+                                }
+                            }
+                        }
+                    }
+                }
 
-                    if (p_n_sdu->rx.buf.rmng < CanTp_GetRxBlockSize(p_n_sdu))
+                if ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u)
+                {
+                    if (p_n_sdu->tx->geometry.af_valid == TRUE)
                     {
-                        /* SWS_CanTp_00341: If the N_Br timer expires and the available buffer size
-                         * is still not big enough, the CanTp module shall send a new FC(WAIT) to
-                         * suspend the N-SDU reception and reload the N_Br timer. */
-                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+                        n_ae_field_size = CanTp_GetNAiSize(&p_n_sdu->tx->geometry);
+
+                        if (CanTp_DecodePCIValue(&pci, &pPduInfo->SduDataPtr[n_ae_field_size]) == E_OK)
+                        {
+                            next_state = CANTP_FRAME_STATE_INVALID;
+                            p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_TX, p_n_sdu->tx_shared.state);
+
+                            if ((p_handler->indication != NULL_PTR) && (p_handler->pci == pci))
+                            {
+                                next_state = p_handler->indication(p_n_sdu, pPduInfo, n_ae_field_size);
+                            }
+
+                            if (next_state != CANTP_FRAME_STATE_INVALID)
+                            {
+                                p_n_sdu->tx_shared.state = next_state;
+                            }
+                        }
                     }
+                }
 
-                    tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
+                /* the connection pool entry or the connection is given back if the N-PDU did not
+                 * start a session. */
+                CanTp_ReleaseNSdu(p_n_sdu);
+            }
+        }
+        else
+        {
+            CanTp_ReportError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_INVALID_RX_ID);
+        }
+    }
+    else
+    {
+        CanTp_ReportError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_PARAM_POINTER);
+    }
+}
+
+void CanTp_TxConfirmation(PduIdType txPduId, Std_ReturnType result)
+{
+    CanTp_FrameStateType next_state;
+    const CanTp_StateHandlerType *p_handler;
+    CanTp_NSduType *p_n_sdu;
+
+    if (CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK)
+    {
+        p_n_sdu = CanTp_GetConfirmedNSdu(p_n_sdu);
+
+        if (result == E_OK)
+        {
+            if ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u)
+            {
+                next_state = CANTP_FRAME_STATE_INVALID;
+                p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_RX, p_n_sdu->rx_shared.state);
+
+                if (p_handler->confirmation != NULL_PTR)
+                {
+                    next_state = p_handler->confirmation(p_n_sdu);
                 }
-                else
+
+                if (next_state != CANTP_FRAME_STATE_INVALID)
                 {
-                    /* SWS_CanTp_00223: The CanTp module shall send a maximum of WFTmax consecutive
-                     * FC(WAIT) N-PDU. If this number is reached, the CanTp module shall abort the
-                     * reception of this N-SDU (the receiver did not send any FC N-PDU, so the N_Bs
-                     * timer expires on the sender side and then the transmission is aborted) and a
-                     * receiving indication with E_NOT_OK occurs. */
-                    tmp_return = CANTP_FRAME_STATE_ABORT;
+                    p_n_sdu->rx_shared.state = next_state;
                 }
             }
-            else
+
+            if ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u)
             {
-                if (p_n_sdu->rx.buf.rmng >= CanTp_GetRxBlockSize(p_n_sdu))
+                next_state = CANTP_FRAME_STATE_INVALID;
+                p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_TX, p_n_sdu->tx_shared.state);
+
+                if (p_handler->confirmation != NULL_PTR)
                 {
-                    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
-                    p_n_sdu->rx.fs = CANTP_FLOW_STATUS_TYPE_CTS;
+                    next_state = p_handler->confirmation(p_n_sdu);
+                }
 
-                    tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
+                if (next_state != CANTP_FRAME_STATE_INVALID)
+                {
+                    p_n_sdu->tx_shared.state = next_state;
+
+                    /* if STmin has already elapsed, the next CF is sent right away as long as the
+                     * burst budget of the current period is not exhausted. */
+                    if ((next_state == CANTP_TX_FRAME_STATE_CF_TX_REQUEST) &&
+                        (p_n_sdu->tx->burst_cnt < p_n_sdu->tx->cfg->burstSize))
+                    {
+                        CanTp_PerformStepTxCF(p_n_sdu);
+                    }
+                    else
+                    {
+                        /* the confirmed CF leaves a free slot in the transmit window. */
+                        CanTp_FillTxWindow(p_n_sdu);
+                    }
                 }
             }
         }
-        else if (p_n_sdu->rx.fs == CANTP_FLOW_STATUS_TYPE_OVFLW)
-        {
-            tmp_return = CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION;
-        }
         else
         {
-            tmp_return = CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION;
+            /* SWS_CanTp_00355: CanTp shall abort the corresponding session, when
+             * CanTp_TxConfirmation() is called with the result E_NOT_OK. */
+            CanTp_AbortTxSession(p_n_sdu, CANTP_I_NONE, FALSE);
         }
+    }
+}
 
-        p_n_sdu->rx.buf.can[ofs] = (0x03u << 0x04u) | (uint8)p_n_sdu->rx.fs;
-        ofs ++;
-        p_n_sdu->rx.buf.can[ofs] = p_n_sdu->rx.cfg->bs;
-        ofs ++;
-        p_n_sdu->rx.buf.can[ofs] = CanTp_EncodeSTMinValue(p_n_sdu->rx.shared.m_param.st_min);
-        ofs ++;
+/** @} */
 
-        /* SWS_CanTp_00348: if frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
-         * frames) are used for a Tx N-SDU and if CanTpTxPaddingActivation is equal to CANTP_ON,
-         * CanTp shall transmit by means of CanIf_Transmit() call, SF Tx N-PDU or last CF Tx N-PDU
-         * that belongs to that Tx N-SDU with the length of eight bytes(i.e. PduInfoPtr.SduLength =
-         * 8). Unused bytes in N-PDU shall be updated with CANTP_PADDING_BYTE (see
-         * ECUC_CanTp_00298). */
-        if ((CanTp_StateType)p_n_sdu->rx.cfg->padding == (CanTp_StateType)CANTP_ON)
-        {
-            CanTp_SetPadding(&p_n_sdu->rx.buf.can[0x00u], &ofs, CanTp_ConfigPtr->paddingByte);
-        }
 
-        p_pdu_info->SduDataPtr = &p_n_sdu->rx.buf.can[0x00u];
-        p_pdu_info->MetaDataPtr = NULL_PTR;
-        p_pdu_info->SduLength = ofs;
-    }
+/*-----------------------------------------------------------------------------------------------*/
+/* local function definitions (static).                                                          */
+/*-----------------------------------------------------------------------------------------------*/
 
-    return tmp_return;
+/**
+ * @addtogroup CANTP_C_LFDEF
+ * @{
+ */
+
+static void CanTp_ClearMemory(void *pMemory, uint32 size)
+{
+    uint8 *p_cleared_data = (uint8 *)pMemory;
+    uint32_least idx;
+
+    for (idx = 0x00u; idx < size; idx++)
+    {
+        p_cleared_data[idx] = 0x00u;
+    }
 }
 
-static CanTp_FrameStateType
-CanTp_LDataIndRSF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+static const CanTp_PduIdMapType *CanTp_GetPduIdMapEntry(const CanTp_ConfigType *pConfig,
+                                                        PduIdType pduId,
+                                                        uint32_least channelIdx)
 {
-    PduLengthType dl;
-    PduLengthType header_size;
-    BufReq_ReturnType status;
-    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
-    CanTp_NSduType *p_n_sdu = pNSdu;
+    const CanTp_PduIdMapType *p_map = NULL_PTR;
 
-    if (p_n_sdu->rx.shared.taskState == CANTP_PROCESSING)
+    if ((pConfig->pPduIdMap != NULL_PTR) &&
+        (pduId >= pConfig->pduIdMapBase) &&
+        ((PduIdType)(pduId - pConfig->pduIdMapBase) < pConfig->pduIdMapSize))
     {
-        /* SWS_CanTp_00057: Terminate the current reception, report an indication, with parameter
-         * Result set to E_NOT_OK, to the upper layer, and process the SF/FF N-PDU as the start of a
-         * new reception */
-        PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+        p_map = &pConfig->pPduIdMap[pduId - pConfig->pduIdMapBase];
 
-        CanTp_ReportRuntimeError(CANTP_I_RX_SF, CANTP_RX_INDICATION_API_ID, CANTP_E_UNEXP_PDU);
+        /* reject entries which do not belong to the given channel or which do not fit into its
+         * runtime storage. */
+        if ((p_map->direction == 0x00u) ||
+            (p_map->channel != channelIdx) ||
+            (p_map->nSdu >= pConfig->pChannelRt[channelIdx].nSduCnt))
+        {
+            p_map = NULL_PTR;
+        }
+        else
+        {
+            /* MISRA C, do nothing. */
+        }
     }
     else
     {
-        CANTP_ENTER_CRITICAL_SECTION
-        p_n_sdu->rx.shared.taskState = CANTP_PROCESSING;
-        CANTP_EXIT_CRITICAL_SECTION
+        /* MISRA C, do nothing. */
     }
 
-    /* SWS_CanTp_00345: If frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD frames)
-     * are used for a Rx N-SDU and CanTpRxPaddingActivation is equal to CANTP_ON, then CanTp
-     * receives by means of CanTp_RxIndication() call an SF Rx N-PDU belonging to that N-SDU, with a
-     * length smaller than eight bytes (i.e. PduInfoPtr.SduLength < 8), CanTp shall reject the
-     * reception. The runtime error code CANTP_E_PADDING shall be reported to the Default Error
-     * Tracer. */
-    header_size = CANTP_SF_PCI_FIELD_SIZE + nAeSize;
-
-    dl = CanTp_DecodeDLValue(CANTP_N_PCI_TYPE_SF,
-                             p_n_sdu->rx.cfg->padding,
-                             &pPduInfo->SduDataPtr[nAeSize]);
-
-    p_n_sdu->rx.buf.size = dl;
+    return p_map;
+}
 
-    p_n_sdu->rx.pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
-    p_n_sdu->rx.pdu_r_pdu_info.SduLength = dl;
-    p_n_sdu->rx.pdu_r_pdu_info.MetaDataPtr = NULL_PTR;
+static Std_ReturnType CanTp_GetNSduFromPduId(PduIdType pduId, CanTp_NSduType **pNSdu)
+{
+    Std_ReturnType tmp_return = E_NOT_OK;
+    const CanTp_PduIdMapType *p_map;
 
-    status = PduR_CanTpStartOfReception(p_n_sdu->rx.cfg->nSduId,
-                                        &p_n_sdu->rx.pdu_r_pdu_info,
-                                        dl,
-                                        &p_n_sdu->rx.buf.rmng);
-    if (status == BUFREQ_OK)
+    if ((CanTp_ConfigPtr != NULL_PTR) &&
+        (pduId >= CANTP_CONFIG_PTR->pduIdMapBase) &&
+        ((PduIdType)(pduId - CANTP_CONFIG_PTR->pduIdMapBase) < CANTP_CONFIG_PTR->pduIdMapSize))
     {
-        /* SWS_CanTp_00339: After the reception of a First Frame or Single Frame, if the
-         * function PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
-         * buffer size than needed for the already received data, the CanTp module shall
-         * abort the reception of the N-SDU and call PduR_CanTpRxIndication() with the
-         * result E_NOT_OK. */
-        if (p_n_sdu->rx.buf.rmng < dl)
-        {
-            PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+        p_map = &CANTP_CONFIG_PTR->pPduIdMap[pduId - CANTP_CONFIG_PTR->pduIdMapBase];
 
-            /* TODO:return STATE_OK? */
-            result = CANTP_FRAME_STATE_ABORT;
+        /* the map has been validated by CanTp_Init, a direct lookup is sufficient here. */
+        if (p_map->direction != 0x00u)
+        {
+            *pNSdu = &CANTP_CONFIG_PTR->pChannelRt[p_map->channel].pNSdu[p_map->nSdu];
+            tmp_return = E_OK;
         }
         else
         {
-            if (CanTp_CopyRxPayload(p_n_sdu) == BUFREQ_OK)
-            {
-                result = CANTP_FRAME_STATE_OK;
-                PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_OK);
-            }
-            else
-            {
-                /* TODO: handle other return values. */
-
-                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
-                 * reception of a Consecutive Frame in a block the CanTp shall abort the
-                 * reception of N-SDU and notify the PduR module by calling the
-                 * PduR_CanTpRxIndication() with the result E_NOT_OK. */
-                result = CANTP_FRAME_STATE_ABORT;
-                PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
-            }
+            /* MISRA C, do nothing. */
         }
     }
-    else if ((status == BUFREQ_E_BUSY) || (status == BUFREQ_E_NOT_OK))
-    {
-        /* SWS_CanTp_00081: ⌈After the reception of a First Frame or Single Frame, if the
-         * function PduR_CanTpStartOfReception()returns BUFREQ_E_NOT_OK to the CanTp module, the
-         * CanTp module shall abort the reception of this N-SDU. No Flow Control will be sent
-         * and PduR_CanTpRxIndication() will not be called in this case. */
-        result = CANTP_FRAME_STATE_ABORT;
-    }
-    else if (status == BUFREQ_E_OVFL)
-    {
-        /* SWS_CanTp_00353: After the reception of a Single Frame, if the function
-         * PduR_CanTpStartOfReception()returns BUFREQ_E_OVFL to the CanTp module, the CanTp
-         * module shall abort the N-SDU reception. */
-        result = CANTP_FRAME_STATE_ABORT;
-    }
     else
     {
         /* MISRA C, do nothing. */
     }
 
-    return result;
+    return tmp_return;
 }
 
-static CanTp_FrameStateType
-CanTp_LDataIndRFF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+static void CanTp_ActivateNSdu(CanTp_NSduType *pNSdu)
 {
-    PduLengthType header_size;
-    PduLengthType payload_size;
-    BufReq_ReturnType status;
-    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
-    CanTp_NSduType *p_n_sdu = pNSdu;
-
-    if (p_n_sdu->rx.shared.taskState == CANTP_PROCESSING)
-    {
-        /* SWS_CanTp_00057: Terminate the current reception, report an indication, with parameter
-         * Result set to E_NOT_OK, to the upper layer, and process the SF/FF N-PDU as the start of a
-         * new reception */
-        PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+    CANTP_ENTER_CRITICAL_SECTION
 
-        CanTp_ReportRuntimeError(CANTP_I_RX_FF, CANTP_RX_INDICATION_API_ID, CANTP_E_UNEXP_PDU);
-    }
-    else
+    if (pNSdu->active.linked != TRUE)
     {
-        CANTP_ENTER_CRITICAL_SECTION
-        p_n_sdu->rx.shared.taskState = CANTP_PROCESSING;
-        CANTP_EXIT_CRITICAL_SECTION
+        pNSdu->active.prev = NULL_PTR;
+        pNSdu->active.next = CanTp_ActiveNSdu;
+
+        if (CanTp_ActiveNSdu != NULL_PTR)
+        {
+            CanTp_ActiveNSdu->active.prev = pNSdu;
+        }
+
+        CanTp_ActiveNSdu = pNSdu;
+        pNSdu->active.linked = TRUE;
     }
 
-    header_size = CANTP_FF_PCI_FIELD_SIZE + nAeSize;
-    payload_size = CANTP_CAN_FRAME_SIZE - header_size;
+    CANTP_EXIT_CRITICAL_SECTION
+}
 
-    p_n_sdu->rx.buf.size = CanTp_DecodeDLValue(CANTP_N_PCI_TYPE_FF,
-                                               p_n_sdu->rx.cfg->padding,
-                                               &pPduInfo->SduDataPtr[nAeSize]);
+static void CanTp_DeactivateNSdu(CanTp_NSduType *pNSdu)
+{
+    CANTP_ENTER_CRITICAL_SECTION
 
-    p_n_sdu->rx.sn = 0x00u;
-    p_n_sdu->rx.wft_max = p_n_sdu->rx.cfg->wftMax;
-    p_n_sdu->rx.bs = p_n_sdu->rx.shared.m_param.bs;
+    if ((pNSdu->active.linked == TRUE) &&
+        (pNSdu->rx_shared.taskState != CANTP_PROCESSING) &&
+        (pNSdu->tx_shared.taskState != CANTP_PROCESSING))
+    {
+        if (pNSdu->active.prev != NULL_PTR)
+        {
+            pNSdu->active.prev->active.next = pNSdu->active.next;
+        }
+        else
+        {
+            CanTp_ActiveNSdu = pNSdu->active.next;
+        }
 
-    p_n_sdu->rx.pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
-    p_n_sdu->rx.pdu_r_pdu_info.SduLength = pPduInfo->SduLength - header_size;
-    p_n_sdu->rx.pdu_r_pdu_info.MetaDataPtr = NULL_PTR;
+        if (pNSdu->active.next != NULL_PTR)
+        {
+            pNSdu->active.next->active.prev = pNSdu->active.prev;
+        }
 
-    /* TODO: as I understand, the N_Br is the time allowed for the upper layer to provide the
-     *  required buffer. thus, the N_Br timeout will be handled according to SWS_CanTp_00082. */
+        pNSdu->active.prev = NULL_PTR;
+        pNSdu->active.next = NULL_PTR;
+        pNSdu->active.linked = FALSE;
+    }
 
-    /* SWS_CanTp_00166: At the reception of a FF or last CF of a block, the CanTp module shall start
-     * a time-out N_Br before calling PduR_CanTpStartOfReception or PduR_CanTpCopyRxData.
-     *
-     * CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR); */
+    CANTP_EXIT_CRITICAL_SECTION
+}
 
-    status = PduR_CanTpStartOfReception(p_n_sdu->rx.cfg->nSduId,
-                                        &p_n_sdu->rx.pdu_r_pdu_info,
-                                        p_n_sdu->rx.buf.size,
-                                        &p_n_sdu->rx.buf.rmng);
-    if (status == BUFREQ_OK)
+static Std_ReturnType CanTp_BindPeer(CanTp_NSduType **pNSdu,
+                                     const uint8 *pMetaData,
+                                     const boolean received)
+{
+    CanTp_NSduType *p_template = *pNSdu;
+    CanTp_PeerType *p_peer;
+    CanTp_PeerType *p_free = NULL_PTR;
+    Std_ReturnType tmp_return = E_NOT_OK;
+    uint32_least idx;
+    uint32 can_id;
+    uint32 response_id;
+    uint32 rx_id;
+    uint32 tx_id;
+    uint8 local;
+    uint8 remote;
+
+    if (pMetaData != NULL_PTR)
     {
-        /* SWS_CanTp_00339: After the reception of a First Frame or Single Frame, if the
-         * function PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
-         * buffer size than needed for the already received data, the CanTp module shall abort
-         * the reception of the N-SDU and call PduR_CanTpRxIndication() with the result
-         * E_NOT_OK. */
-        if (p_n_sdu->rx.buf.rmng < payload_size)
-        {
-            PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+        can_id = (uint32)pMetaData[0x00u] |
+                 ((uint32)pMetaData[0x01u] << 8u) |
+                 ((uint32)pMetaData[0x02u] << 16u) |
+                 ((uint32)pMetaData[0x03u] << 24u);
 
-            result = CANTP_FRAME_STATE_ABORT;
+        /* normal fixed and mixed 29 bits addressing formats: N_TA is located in bits 8 to 15 of
+         * the CAN identifier and N_SA in bits 0 to 7, the N-PDUs exchanged in the opposite
+         * direction use the same identifier with both addresses swapped. */
+        response_id = (can_id & 0xFFFF0000u) | ((can_id & 0x000000FFu) << 8u) | ((can_id >> 8u) & 0xFFu);
+
+        if (received == TRUE)
+        {
+            local = (uint8)(can_id >> 8u);
+            remote = (uint8)can_id;
+            rx_id = can_id;
+            tx_id = response_id;
         }
         else
         {
-            result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+            local = (uint8)can_id;
+            remote = (uint8)(can_id >> 8u);
+            rx_id = response_id;
+            tx_id = can_id;
+        }
 
-            if (p_n_sdu->rx.buf.rmng < CanTp_GetRxBlockSize(p_n_sdu))
-            {
-                /* SWS_CanTp_00082: After the reception of a First Frame, if the function
-                 * PduR_CanTpStartOfReception() returns BUFREQ_OK with a smaller available
-                 * buffer size than needed for the next block, the CanTp module shall start the
-                 * timer N_Br. */
-                CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
+        /* the pool is shared between CanTp_RxIndication and CanTp_Transmit, the lookup and the
+         * claim of a free entry must not be interrupted. */
+        CANTP_ENTER_CRITICAL_SECTION
 
-                p_n_sdu->rx.fs = CANTP_FLOW_STATUS_TYPE_WT;
-            }
-            else
+        for (idx = 0x00u; (idx < CANTP_CONFIG_PTR->peerCnt) && (tmp_return != E_OK); idx++)
+        {
+            p_peer = &CANTP_CONFIG_PTR->pPeer[idx];
+
+            if ((p_peer->p_template == p_template) &&
+                (p_peer->local == local) &&
+                (p_peer->remote == remote))
             {
-                p_n_sdu->rx.fs = CANTP_FLOW_STATUS_TYPE_CTS;
+                *pNSdu = &p_peer->n_sdu;
+                tmp_return = E_OK;
             }
-
-            if (CanTp_CopyRxPayload(p_n_sdu) != BUFREQ_OK)
+            else if ((p_peer->p_template == NULL_PTR) && (p_free == NULL_PTR))
             {
-                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
-                 * reception of a Consecutive Frame in a block the CanTp shall abort the
-                 * reception of N-SDU and notify the PduR module by calling the
-                 * PduR_CanTpRxIndication() with the result E_NOT_OK. */
-                result = CANTP_FRAME_STATE_ABORT;
-                PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+                p_free = p_peer;
             }
             else
             {
-                /* TODO: handle other return values. */
+                /* MISRA C, do nothing. */
             }
         }
+
+        if ((tmp_return != E_OK) && (p_free != NULL_PTR))
+        {
+            /* the entry inherits the configuration, the frame geometry and the parameters of the
+             * dynamically addressed N-SDU. */
+            p_free->p_template = p_template;
+            p_free->local = local;
+            p_free->remote = remote;
+            p_free->pending = 0x00u;
+            p_free->deferred = FALSE;
+
+            for (idx = 0x00u; idx < CANTP_META_DATA_SIZE; idx++)
+            {
+                p_free->rx_meta[idx] = (uint8)(rx_id >> (idx * 8u));
+                p_free->tx_meta[idx] = (uint8)(tx_id >> (idx * 8u));
+            }
+
+            CanTp_InitRxConnection(&p_free->rx, p_template->rx_cfg);
+            CanTp_InitTxConnection(&p_free->tx, p_template->tx_cfg);
+            p_free->tx.can_if_pdu_info.MetaDataPtr = &p_free->tx_meta[0x00u];
+
+            p_free->n_sdu.dir = p_template->dir;
+            p_free->n_sdu.channel = p_template->channel;
+            p_free->n_sdu.rx_cfg = p_template->rx_cfg;
+            p_free->n_sdu.tx_cfg = p_template->tx_cfg;
+            p_free->n_sdu.m_param = p_template->m_param;
+            p_free->n_sdu.rx_shared = p_template->rx_shared;
+            p_free->n_sdu.tx_shared = p_template->tx_shared;
+
+            *pNSdu = &p_free->n_sdu;
+            tmp_return = E_OK;
+        }
+
+        CANTP_EXIT_CRITICAL_SECTION
     }
-    else if ((status == BUFREQ_E_BUSY) || (status == BUFREQ_E_NOT_OK))
-    {
-        /* SWS_CanTp_00081: After the reception of a First Frame or Single Frame, if the
-         * function PduR_CanTpStartOfReception()returns BUFREQ_E_NOT_OK to the CanTp module,
-         * the CanTp module shall abort the reception of this N-SDU. No Flow Control will be
-         * sent and PduR_CanTpRxIndication() will not be called in this case. */
-        result = CANTP_FRAME_STATE_ABORT;
-    }
-    else if (status == BUFREQ_E_OVFL)
+
+    return tmp_return;
+}
+
+static void CanTp_ReleaseNSdu(CanTp_NSduType *pNSdu)
+{
+    CanTp_PeerType *p_peer = pNSdu->p_peer;
+    const boolean pooled_rx = (boolean)((p_peer == NULL_PTR) &&
+                                        (CANTP_CONFIG_PTR->rxConnectionPoolSize > 0x00u) &&
+                                        (pNSdu->rx != &CanTp_IdleRxConnection));
+    const boolean pooled_tx = (boolean)((p_peer == NULL_PTR) &&
+                                        (CANTP_CONFIG_PTR->txConnectionPoolSize > 0x00u) &&
+                                        (pNSdu->tx != &CanTp_IdleTxConnection));
+    uint8 instance_id;
+
+    if (((p_peer != NULL_PTR) || (pooled_rx == TRUE) || (pooled_tx == TRUE)) &&
+        (pNSdu->active.linked != TRUE) &&
+        (pNSdu->rx_shared.taskState != CANTP_PROCESSING) &&
+        (pNSdu->tx_shared.taskState != CANTP_PROCESSING))
     {
-        /* SWS_CanTp_00318: After the reception of a First Frame, if the function
-         * PduR_CanTpStartOfReception() returns BUFREQ_E_OVFL to the CanTp module, the CanTp
-         * module shall send a Flow Control N-PDU with overflow status (FC(OVFLW)) and abort the
-         * N-SDU reception. */
-        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
-        p_n_sdu->rx.fs = CANTP_FLOW_STATUS_TYPE_OVFLW;
+        /* the timers left running by the ended sessions must not fire once the entry or the
+         * connections are bound to another peer or N-SDU. */
+        for (instance_id = 0x00u; instance_id < CANTP_NUM_OF_TIMER_PER_N_SDU; instance_id++)
+        {
+            CanTp_StopNetworkLayerTimeout(pNSdu, instance_id);
+        }
+
+        CANTP_ENTER_CRITICAL_SECTION
+
+        if (p_peer != NULL_PTR)
+        {
+            /* a late confirmation of an N-PDU of the entry is not routed to another entry. */
+            if (p_peer->p_template->p_unconfirmed == p_peer)
+            {
+                p_peer->p_template->p_unconfirmed = NULL_PTR;
+            }
+
+            p_peer->p_template = NULL_PTR;
+            p_peer->pending = 0x00u;
+        }
+
+        /* a late confirmation must not be processed by an N-SDU without connection. */
+        if (pooled_rx == TRUE)
+        {
+            pNSdu->rx->cfg = NULL_PTR;
+            pNSdu->rx = &CanTp_IdleRxConnection;
+            pNSdu->rx_shared.state = CANTP_FRAME_STATE_INVALID;
+            CanTp_ConnectionPoolStatus.rx_in_use--;
+        }
+
+        if (pooled_tx == TRUE)
+        {
+            pNSdu->tx->cfg = NULL_PTR;
+            pNSdu->tx = &CanTp_IdleTxConnection;
+            pNSdu->tx_shared.state = CANTP_FRAME_STATE_INVALID;
+            CanTp_ConnectionPoolStatus.tx_in_use--;
+        }
+
+        CANTP_EXIT_CRITICAL_SECTION
     }
-    else
+}
+
+static void CanTp_InitRxConnection(CanTp_RxConnectionType *pConnection, const CanTp_RxNSduType *pCfg)
+{
+    CanTp_ClearMemory(pConnection, sizeof(CanTp_RxConnectionType));
+
+    pConnection->cfg = pCfg;
+
+    if (pCfg != NULL_PTR)
     {
-        /* MISRA C, do nothing. */
+        CanTp_InitFrameGeometry(&pConnection->geometry, pCfg->af, pCfg->pNAe, pCfg->pNTa, pCfg->rxDl);
     }
-
-    return result;
 }
 
-static CanTp_FrameStateType
-CanTp_LDataIndRCF(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+static void CanTp_InitTxConnection(CanTp_TxConnectionType *pConnection, const CanTp_TxNSduType *pCfg)
 {
-    PduLengthType header_size;
-    CanTp_FrameStateType result = CANTP_FRAME_STATE_INVALID;
-    CanTp_NSduType *p_n_sdu = pNSdu;
+    CanTp_ClearMemory(pConnection, sizeof(CanTp_TxConnectionType));
 
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
+    pConnection->cfg = pCfg;
 
-    if (p_n_sdu->rx.shared.taskState == CANTP_PROCESSING)
+    if (pCfg != NULL_PTR)
     {
-        if ((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) == ((p_n_sdu->rx.sn + 0x01u) & 0x0Fu))
-        {
-            header_size = CANTP_CF_PCI_FIELD_SIZE + nAeSize;
+        CanTp_InitFrameGeometry(&pConnection->geometry, pCfg->af, pCfg->pNAe, pCfg->pNTa, pCfg->txDl);
+    }
+}
+
+static Std_ReturnType CanTp_BindRxConnection(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo)
+{
+    CanTp_RxConnectionType *p_rx;
+    CanTp_NPciType pci;
+    PduLengthType n_ae_field_size;
+    Std_ReturnType tmp_return = E_OK;
+    uint32_least idx;
 
-            p_n_sdu->rx.sn++;
-            p_n_sdu->rx.bs--;
+    if (pNSdu->rx == &CanTp_IdleRxConnection)
+    {
+        tmp_return = E_NOT_OK;
 
-            p_n_sdu->rx.pdu_r_pdu_info.SduDataPtr = &pPduInfo->SduDataPtr[header_size];
-            p_n_sdu->rx.pdu_r_pdu_info.SduLength = pPduInfo->SduLength - header_size;
-            p_n_sdu->rx.pdu_r_pdu_info.MetaDataPtr = NULL_PTR;
+        /* only a SF or a FF may start a reception, any other N-PDU is ignored by an N-SDU without
+         * connection anyway. */
+        if ((CanTp_DecodeNAIValue(pNSdu->rx_cfg->af, &n_ae_field_size) == E_OK) &&
+            (CanTp_DecodePCIValue(&pci, &pPduInfo->SduDataPtr[n_ae_field_size]) == E_OK) &&
+            ((pci == CANTP_N_PCI_TYPE_SF) || (pci == CANTP_N_PCI_TYPE_FF)))
+        {
+            CANTP_ENTER_CRITICAL_SECTION
 
-            if (CanTp_CopyRxPayload(p_n_sdu) == BUFREQ_OK)
+            for (idx = 0x00u; (idx < CANTP_CONFIG_PTR->rxConnectionPoolSize) && (tmp_return != E_OK); idx++)
             {
-                if (p_n_sdu->rx.buf.size != 0x00u)
+                p_rx = &CANTP_CONFIG_PTR->pRxConnectionPool[idx];
+
+                if (p_rx->cfg == NULL_PTR)
                 {
-                    if (p_n_sdu->rx.bs == 0x00u)
-                    {
-                        p_n_sdu->rx.bs = p_n_sdu->rx.shared.m_param.bs;
+                    CanTp_InitRxConnection(p_rx, pNSdu->rx_cfg);
+                    pNSdu->rx = p_rx;
 
-                        /* SWS_CanTp_00166: At the reception of a FF or last CF of a block, the CanTp
-                         * module shall start a time-out N_Br before calling PduR_CanTpStartOfReception
-                         * or PduR_CanTpCopyRxData. */
-                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BR);
-                        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
-                    }
-                    else
+                    CanTp_ConnectionPoolStatus.rx_in_use++;
+
+                    if (CanTp_ConnectionPoolStatus.rx_in_use > CanTp_ConnectionPoolStatus.rx_high_water)
                     {
-                        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
-                        result = CANTP_RX_FRAME_STATE_CF_RX_INDICATION;
+                        CanTp_ConnectionPoolStatus.rx_high_water = CanTp_ConnectionPoolStatus.rx_in_use;
                     }
-                }
-                else
-                {
-                    PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_OK);
-                    result = CANTP_FRAME_STATE_OK;
+
+                    tmp_return = E_OK;
                 }
             }
-            else
+
+            if (tmp_return != E_OK)
             {
-                /* SWS_CanTp_00271: If the PduR_CanTpCopyRxData() returns BUFREQ_E_NOT_OK after
-                 * reception of a Consecutive Frame in a block the CanTp shall abort the reception
-                 * of N-SDU and notify the PduR module by calling the PduR_CanTpRxIndication() with
-                 * the result E_NOT_OK. */
-                PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
-                result = CANTP_FRAME_STATE_ABORT;
+                CanTp_ConnectionPoolStatus.rx_rejected++;
+            }
+
+            CANTP_EXIT_CRITICAL_SECTION
+
+            if ((tmp_return != E_OK) &&
+                (pci == CANTP_N_PCI_TYPE_FF) &&
+                (pNSdu->rx_cfg->taType == CANTP_PHYSICAL) &&
+                (CANTP_CONFIG_PTR->poolPolicy == CANTP_POOL_POLICY_OVERFLOW))
+            {
+                CanTp_TransmitOverflowFC(pNSdu);
             }
-        }
-        else
-        {
-            /* SWS_CanTp_00314: The CanTp shall check the correctness of each SN received during a
-             * segmented reception. In case of wrong SN received the CanTp module shall abort
-             * reception and notify the upper layer of this failure by calling the indication
-             * function PduR_CanTpRxIndication() with the result E_NOT_OK. */
-            result = CANTP_FRAME_STATE_ABORT;
-            PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
         }
     }
 
-    return result;
+    return tmp_return;
 }
 
-static CanTp_FrameStateType
-CanTp_LDataIndTFC(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo, const PduLengthType nAeSize)
+static Std_ReturnType CanTp_BindTxConnection(CanTp_NSduType *pNSdu)
 {
-    CanTp_FrameStateType result;
-    CanTp_NSduType *p_n_sdu = pNSdu;
-
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
+    CanTp_TxConnectionType *p_tx;
+    Std_ReturnType tmp_return = E_OK;
+    uint32_least idx;
 
-    /* SWS_CanTp_00349: if CanTpTxPaddingActivation is equal to CANTP_ON for a Tx N-SDU, and if a FC
-     * N-PDU is received for that Tx N-SDU on a ongoing transmission, by means of
-     * CanTp_RxIndication() call, and the length of this FC is smaller than eight bytes (i.e.
-     * PduInfoPtr.SduLength <8) the CanTp module shall abort the transmission session by calling
-     * PduR_CanTpTxConfirmation() with the result E_NOT_OK. The runtime error code CANTP_E_PADDING
-     * shall be reported to the Default Error Tracer. */
-    if (!((pNSdu->tx.cfg->padding == CANTP_ON) && (pPduInfo->SduLength < CANTP_CAN_FRAME_SIZE)))
+    if (pNSdu->tx == &CanTp_IdleTxConnection)
     {
-        p_n_sdu->tx.fs = (CanTp_FlowStatusType)pPduInfo->SduDataPtr[nAeSize] & 0x0Fu;
-        p_n_sdu->tx.bs = pPduInfo->SduDataPtr[nAeSize + 0x01u];
-        p_n_sdu->tx.target_st_min = CanTp_DecodeSTMinValue(pPduInfo->SduDataPtr[nAeSize + 0x02u]);
+        tmp_return = E_NOT_OK;
 
-        /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
-         * confirmation of the FF transmission, last CF of a block transmission and at each
-         * indication of FC with FS=WT (i.e. time until reception of the next FC). */
-        if (p_n_sdu->tx.fs == CANTP_FLOW_STATUS_TYPE_WT)
+        CANTP_ENTER_CRITICAL_SECTION
+
+        for (idx = 0x00u; (idx < CANTP_CONFIG_PTR->txConnectionPoolSize) && (tmp_return != E_OK); idx++)
         {
-            CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
+            p_tx = &CANTP_CONFIG_PTR->pTxConnectionPool[idx];
+
+            if (p_tx->cfg == NULL_PTR)
+            {
+                CanTp_InitTxConnection(p_tx, pNSdu->tx_cfg);
+                pNSdu->tx = p_tx;
+
+                CanTp_ConnectionPoolStatus.tx_in_use++;
+
+                if (CanTp_ConnectionPoolStatus.tx_in_use > CanTp_ConnectionPoolStatus.tx_high_water)
+                {
+                    CanTp_ConnectionPoolStatus.tx_high_water = CanTp_ConnectionPoolStatus.tx_in_use;
+                }
+
+                tmp_return = E_OK;
+            }
         }
 
-        /* ISO15765:
-         * 00: The BS parameter value zero (0) shall be used to indicate to the sender that no more
-         * FC frames shall be sent during the transmission of the segmented message. The sending
-         * network layer entity shall send all remaining consecutive frames without any stop for
-         * further FC frames from the receiving network layer entity.
-         * 01-FF: This range of BS parameter values shall be used to indicate to the sender the
-         * maximum number of consecutive frames that can be received without an intermediate FC
-         * frame from the receiving network entity.*/
-        if (p_n_sdu->tx.bs == 0x00u)
+        if (tmp_return != E_OK)
         {
-            p_n_sdu->tx.bs = CANTP_BS_INFINITE;
+            CanTp_ConnectionPoolStatus.tx_rejected++;
         }
 
-        result = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+        CANTP_EXIT_CRITICAL_SECTION
     }
-    else
-    {
-        PduR_CanTpTxConfirmation(p_n_sdu->tx.cfg->nSduId, E_NOT_OK);
-        CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_PADDING);
 
-        result = CANTP_FRAME_STATE_ABORT;
+    return tmp_return;
+}
+
+static void CanTp_TransmitOverflowFC(CanTp_NSduType *pNSdu)
+{
+    CanTp_RxConnectionType *p_rx = &CanTp_OverflowRxConnection;
+
+    /* the N-SDU temporarily uses the reserved connection to build the FC, no session is started
+     * and the confirmation of the FC is ignored. */
+    CanTp_InitRxConnection(p_rx, pNSdu->rx_cfg);
+    p_rx->fs = CANTP_FLOW_STATUS_TYPE_OVFLW;
+    pNSdu->rx = p_rx;
+
+    if (CanTp_LDataReqRFC(pNSdu) == CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION)
+    {
+        (void)CanTp_TransmitNPdu(pNSdu, p_rx->cfg->rxNSduRef, &p_rx->can_if_pdu_info);
     }
 
-    return result;
+    pNSdu->rx = &CanTp_IdleRxConnection;
 }
 
-static CanTp_FrameStateType CanTp_LDataConTSF(CanTp_NSduType *pNSdu)
+static CanTp_NSduType *CanTp_GetConfirmedNSdu(CanTp_NSduType *pNSdu)
 {
     CanTp_NSduType *p_n_sdu = pNSdu;
+    CanTp_PeerType *p_peer;
 
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AS);
+    if (pNSdu->dynamic == TRUE)
+    {
+        CANTP_ENTER_CRITICAL_SECTION
 
-    return CANTP_FRAME_STATE_OK;
+        p_peer = pNSdu->p_unconfirmed;
+
+        if (p_peer != NULL_PTR)
+        {
+            p_peer->pending--;
+
+            if (p_peer->pending == 0x00u)
+            {
+                pNSdu->p_unconfirmed = NULL_PTR;
+            }
+
+            p_n_sdu = &p_peer->n_sdu;
+        }
+
+        CANTP_EXIT_CRITICAL_SECTION
+    }
+
+    return p_n_sdu;
 }
 
-static CanTp_FrameStateType CanTp_LDataConTFF(CanTp_NSduType *pNSdu)
+static Std_ReturnType CanTp_GetSessionNSdu(CanTp_NSduType **pNSdu, const uint8 direction)
 {
-    CanTp_NSduType *p_n_sdu = pNSdu;
+    CanTp_NSduType *p_template = *pNSdu;
+    CanTp_PeerType *p_peer;
+    CanTp_TaskStateType task_state;
+    Std_ReturnType tmp_return = E_OK;
+    uint32_least idx;
 
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AS);
+    if (p_template->dynamic == TRUE)
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+
+        for (idx = 0x00u; (idx < CANTP_CONFIG_PTR->peerCnt) && (tmp_return == E_OK); idx++)
+        {
+            p_peer = &CANTP_CONFIG_PTR->pPeer[idx];
+
+            if (direction == CANTP_DIRECTION_RX)
+            {
+                task_state = p_peer->n_sdu.rx_shared.taskState;
+            }
+            else
+            {
+                task_state = p_peer->n_sdu.tx_shared.taskState;
+            }
+
+            if ((p_peer->p_template == p_template) && (task_state == CANTP_PROCESSING))
+            {
+                /* the service does not identify the peer, it cannot choose between two sessions. */
+                if (*pNSdu != p_template)
+                {
+                    *pNSdu = p_template;
+                    tmp_return = E_NOT_OK;
+                }
+                else
+                {
+                    *pNSdu = &p_peer->n_sdu;
+                }
+            }
+        }
 
-    /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
-     * confirmation of the FF transmission, last CF of a block transmission and at each indication
-     * of FC with FS=WT (i.e. time until reception of the next FC). */
-    CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
+        CANTP_EXIT_CRITICAL_SECTION
+    }
 
-    return CANTP_TX_FRAME_STATE_FC_RX_INDICATION;
+    return tmp_return;
 }
 
-static CanTp_FrameStateType CanTp_LDataConTCF(CanTp_NSduType *pNSdu)
+static uint32 CanTp_GetTimeout(const CanTp_NSduType *pNSdu, const uint8 instanceId)
 {
-    CanTp_FrameStateType result;
-    CanTp_NSduType *p_n_sdu = pNSdu;
+    uint32 result;
 
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AS);
+    switch (instanceId)
+    {
+        case CANTP_I_N_AS:
+        {
+            result = pNSdu->tx->cfg->nas;
 
-    /* ISO15765: the measurement of the STmin starts after completion of transmission of a
-     * ConsecutiveFrame (CF) and ends at the request for the transmission of the next CF. */
-    CanTp_StartFlowControlTimeout(p_n_sdu);
+            break;
+        }
+        case CANTP_I_N_BS:
+        {
+            result = pNSdu->tx->cfg->nbs;
 
-    if (p_n_sdu->tx.buf.size > 0x00u)
-    {
-        if (p_n_sdu->tx.bs != CANTP_BS_INFINITE)
+            break;
+        }
+        case CANTP_I_N_CS:
         {
-            p_n_sdu->tx.bs--;
+            result = pNSdu->tx->cfg->ncs;
+
+            break;
         }
+        case CANTP_I_N_AR:
+        {
+            result = pNSdu->rx->cfg->nar;
 
-        if (p_n_sdu->tx.bs != 0x00u)
+            break;
+        }
+        case CANTP_I_N_BR:
         {
-            result = CANTP_TX_FRAME_STATE_CF_TX_REQUEST;
+            result = pNSdu->rx->cfg->nbr;
+
+            break;
         }
-        else
+        case CANTP_I_N_CR:
         {
-            /* SWS_CanTp_00315: the CanTp module shall start a timeout observation for N_Bs time at
-             * confirmation of the FF transmission, last CF of a block transmission and at each
-             * indication of FC with FS=WT (i.e. time until reception of the next FC). */
-            CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_BS);
+            result = pNSdu->rx->cfg->ncr;
 
-            result = CANTP_TX_FRAME_STATE_FC_RX_INDICATION;
+            break;
+        }
+        case CANTP_I_ST_MIN:
+        {
+            result = pNSdu->tx->target_st_min;
+
+            break;
+        }
+        default:
+        {
+            result = 0x00u;
+
+            break;
         }
-    }
-    else
-    {
-        result = CANTP_FRAME_STATE_OK;
     }
 
     return result;
 }
 
-static CanTp_FrameStateType CanTp_LDataConRFC(CanTp_NSduType *pNSdu)
+static void CanTp_SiftTimerUp(uint32_least idx)
 {
-    CanTp_FrameStateType result;
-    CanTp_NSduType *p_n_sdu = pNSdu;
-
-    CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_AR);
-    CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CR);
+    const CanTp_TimerType timer = CanTp_TimerHeap[idx];
+    uint32_least parent_idx;
 
-    if (CanTp_NetworkLayerIsActive(p_n_sdu, CANTP_I_N_BR) == FALSE)
-    {
-        result = CANTP_RX_FRAME_STATE_CF_RX_INDICATION;
-    }
-    else
+    while (idx > 0x00u)
     {
-        result = CANTP_RX_FRAME_STATE_FC_TX_REQUEST;
+        parent_idx = (idx - 0x01u) >> 0x01u;
+
+        if (CanTp_DeadlineBefore(timer.deadline, CanTp_TimerHeap[parent_idx].deadline) != TRUE)
+        {
+            break;
+        }
+
+        CanTp_TimerHeap[idx] = CanTp_TimerHeap[parent_idx];
+        CanTp_TimerHeap[idx].p_n_sdu->timer_idx[CanTp_TimerHeap[idx].instance_id] = (uint32)idx;
+        idx = parent_idx;
     }
 
-    return result;
+    CanTp_TimerHeap[idx] = timer;
+    timer.p_n_sdu->timer_idx[timer.instance_id] = (uint32)idx;
 }
 
-void CanTp_RxIndication(PduIdType rxPduId, const PduInfoType *pPduInfo)
+static void CanTp_SiftTimerDown(uint32_least idx)
 {
-    CanTp_FrameStateType next_state;
-    CanTp_NPciType pci;
-    PduLengthType n_ae_field_size;
-    CanTp_NSduType *p_n_sdu;
+    const CanTp_TimerType timer = CanTp_TimerHeap[idx];
+    uint32_least child_idx;
 
-    if (pPduInfo != NULL_PTR)
+    for (child_idx = (idx << 0x01u) + 0x01u;
+         child_idx < CanTp_TimerCnt;
+         child_idx = (idx << 0x01u) + 0x01u)
     {
-        if (CanTp_GetNSduFromPduId(rxPduId, &p_n_sdu) == E_OK)
+        if (((child_idx + 0x01u) < CanTp_TimerCnt) &&
+            (CanTp_DeadlineBefore(CanTp_TimerHeap[child_idx + 0x01u].deadline,
+                                  CanTp_TimerHeap[child_idx].deadline) == TRUE))
         {
-            if ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u)
-            {
-                if (CanTp_DecodeNAIValue(p_n_sdu->rx.cfg->af, &n_ae_field_size) == E_OK)
-                {
-                    if (CanTp_DecodePCIValue(&pci, &pPduInfo->SduDataPtr[n_ae_field_size]) == E_OK)
-                    {
-                        /* SWS_CanTp_00345: If frames with a payload <= 8 (either CAN 2.0 frames or small CAN FD
-                     * frames) are used for a Rx N-SDU and CanTpRxPaddingActivation is equal to CANTP_ON, then
-                     * CanTp receives by means of CanTp_RxIndication() call an SF Rx N-PDU belonging to that
-                     * N-SDU, with a length smaller than eight bytes (i.e. PduInfoPtr.SduLength < 8), CanTp
-                     * shall reject the reception. The runtime error code CANTP_E_PADDING shall be reported to
-                     * the Default Error Tracer. */
-                        if (((CanTp_StateType)p_n_sdu->rx.cfg->padding ==
-                             (CanTp_StateType)CANTP_ON) &&
-                            (pPduInfo->SduLength < CANTP_CAN_FRAME_SIZE))
-                        {
-                            PduR_CanTpRxIndication(p_n_sdu->rx.cfg->nSduId, E_NOT_OK);
+            child_idx++;
+        }
 
-                            CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID,
-                                                     CANTP_E_PADDING);
+        if (CanTp_DeadlineBefore(CanTp_TimerHeap[child_idx].deadline, timer.deadline) != TRUE)
+        {
+            break;
+        }
 
-                            next_state = CANTP_FRAME_STATE_OK;
-                        }
-                            /* SWS_CanTp_00093: If a multiple segmented session occurs (on both receiver and sender
-                             * side) with a handle whose communication type is functional, the CanTp module shall
-                             * reject the request and report the runtime error code CANTP_E_INVALID_TATYPE to the
-                             * Default Error Tracer. */
-                        else if ((p_n_sdu->rx.cfg->taType == CANTP_FUNCTIONAL) &&
-                                 (pci == CANTP_N_PCI_TYPE_FF))
-                        {
-                            CanTp_ReportRuntimeError(0x00u, CANTP_RX_INDICATION_API_ID,
-                                                     CANTP_E_INVALID_TATYPE);
+        CanTp_TimerHeap[idx] = CanTp_TimerHeap[child_idx];
+        CanTp_TimerHeap[idx].p_n_sdu->timer_idx[CanTp_TimerHeap[idx].instance_id] = (uint32)idx;
+        idx = child_idx;
+    }
 
-                            next_state = CANTP_FRAME_STATE_OK;
-                        }
-                        else if (pci == CANTP_N_PCI_TYPE_SF)
-                        {
-                            next_state = CanTp_LDataIndRSF(p_n_sdu, pPduInfo, n_ae_field_size);
-                        }
-                        else if (pci == CANTP_N_PCI_TYPE_FF)
-                        {
-                            next_state = CanTp_LDataIndRFF(p_n_sdu, pPduInfo, n_ae_field_size);
-                        }
-                        else if ((pci == CANTP_N_PCI_TYPE_CF) &&
-                                 (p_n_sdu->rx.shared.state ==
-                                  CANTP_RX_FRAME_STATE_CF_RX_INDICATION))
-                        {
-                            next_state = CanTp_LDataIndRCF(p_n_sdu, pPduInfo, n_ae_field_size);
-                        }
-                        else
-                        {
-                            next_state = CANTP_FRAME_STATE_INVALID;
-                        }
+    CanTp_TimerHeap[idx] = timer;
+    timer.p_n_sdu->timer_idx[timer.instance_id] = (uint32)idx;
+}
 
-                        if (next_state != CANTP_FRAME_STATE_INVALID)
-                        {
-                            p_n_sdu->rx.shared.state = next_state;
-                        }
-                    }
-                }
-            }
+static void CanTp_RemoveTimer(uint32_least idx)
+{
+    CanTp_TimerCnt--;
 
-            if ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u)
-            {
-                if (CanTp_DecodeNAIValue(p_n_sdu->tx.cfg->af, &n_ae_field_size) == E_OK)
-                {
-                    if (CanTp_DecodePCIValue(&pci, &pPduInfo->SduDataPtr[n_ae_field_size]) == E_OK)
-                    {
-                        if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_FC_RX_INDICATION)
-                        {
-                            next_state = CanTp_LDataIndTFC(p_n_sdu, pPduInfo, n_ae_field_size);
-                        }
-                        else
-                        {
-                            next_state = CANTP_FRAME_STATE_INVALID;
-                        }
+    if (idx < CanTp_TimerCnt)
+    {
+        /* fill the hole with the last timer and restore the heap property around it. */
+        CanTp_TimerHeap[idx] = CanTp_TimerHeap[CanTp_TimerCnt];
 
-                        if (next_state != CANTP_FRAME_STATE_INVALID)
-                        {
-                            p_n_sdu->tx.shared.state = next_state;
-                        }
-                    }
-                }
-            }
+        if ((idx > 0x00u) &&
+            (CanTp_DeadlineBefore(CanTp_TimerHeap[idx].deadline,
+                                  CanTp_TimerHeap[(idx - 0x01u) >> 0x01u].deadline) == TRUE))
+        {
+            CanTp_SiftTimerUp(idx);
         }
         else
         {
-            CanTp_ReportError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_INVALID_RX_ID);
+            CanTp_SiftTimerDown(idx);
         }
     }
-    else
-    {
-        CanTp_ReportError(0x00u, CANTP_RX_INDICATION_API_ID, CANTP_E_PARAM_POINTER);
-    }
 }
 
-void CanTp_TxConfirmation(PduIdType txPduId, Std_ReturnType result)
+static void CanTp_UpdateTimers(const uint32 elapsed)
 {
-    CanTp_FrameStateType next_state;
     CanTp_NSduType *p_n_sdu;
+    uint8 instance_id;
 
-    if (CanTp_GetNSduFromPduId(txPduId, &p_n_sdu) == E_OK)
+    CANTP_ENTER_CRITICAL_SECTION
+
+    CanTp_Now += elapsed;
+
+    while ((CanTp_TimerCnt > 0x00u) &&
+           (CanTp_DeadlineBefore(CanTp_Now, CanTp_TimerHeap[0x00u].deadline) != TRUE))
     {
-        if (result == E_OK)
-        {
-            if ((p_n_sdu->dir & CANTP_DIRECTION_RX) != 0x00u)
-            {
-                next_state = CANTP_FRAME_STATE_INVALID;
+        p_n_sdu = CanTp_TimerHeap[0x00u].p_n_sdu;
+        instance_id = CanTp_TimerHeap[0x00u].instance_id;
 
-                if (p_n_sdu->rx.shared.state == CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION)
-                {
-                    next_state = CanTp_LDataConRFC(p_n_sdu);
-                }
+        CanTp_RemoveTimer(0x00u);
+        p_n_sdu->timer.expired |= ((uint32)0x01u << instance_id);
+    }
 
-                if (next_state != CANTP_FRAME_STATE_INVALID)
-                {
-                    p_n_sdu->rx.shared.state = next_state;
-                }
-            }
+    CANTP_EXIT_CRITICAL_SECTION
+}
 
-            if ((p_n_sdu->dir & CANTP_DIRECTION_TX) != 0x00u)
-            {
-                next_state = CANTP_FRAME_STATE_INVALID;
+static void CanTp_ProcessActiveNSdus(void)
+{
+    CanTp_NSduType *p_n_sdu;
+    CanTp_NSduType *p_next_n_sdu;
 
-                if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION)
-                {
-                    next_state = CanTp_LDataConTSF(p_n_sdu);
-                }
-                else if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION)
-                {
-                    next_state = CanTp_LDataConTFF(p_n_sdu);
-                }
-                else if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION)
-                {
-                    next_state = CanTp_LDataConTCF(p_n_sdu);
-                }
-                else
-                {
-                    /* MISRA C, do nothing. */
-                }
+    CanTp_TaskStateType task_state_rx;
+    CanTp_TaskStateType task_state_tx;
 
-                if (next_state != CANTP_FRAME_STATE_INVALID)
-                {
-                    p_n_sdu->tx.shared.state = next_state;
-                }
-            }
-        }
-        else
+    CANTP_ENTER_CRITICAL_SECTION
+    p_n_sdu = CanTp_ActiveNSdu;
+    CANTP_EXIT_CRITICAL_SECTION
+
+    /* only walk the N-SDUs on which a session is ongoing, idle ones do not need any processing
+     * (their timers are (re)started when a new session begins). */
+    while (p_n_sdu != NULL_PTR)
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+        p_next_n_sdu = p_n_sdu->active.next;
+        task_state_rx = p_n_sdu->rx_shared.taskState;
+        CANTP_EXIT_CRITICAL_SECTION
+
+        task_state_tx = p_n_sdu->tx_shared.taskState;
+
+        if (task_state_rx == CANTP_PROCESSING)
         {
-            /* SWS_CanTp_00355: CanTp shall abort the corresponding session, when
-             * CanTp_TxConfirmation() is called with the result E_NOT_OK. */
-            CanTp_AbortTxSession(p_n_sdu, CANTP_I_NONE, FALSE);
+            CanTp_PerformStepRx(p_n_sdu);
         }
-    }
-}
 
-/** @} */
+        if (task_state_tx == CANTP_PROCESSING)
+        {
+            CanTp_PerformStepTx(p_n_sdu);
+        }
 
+        CanTp_DeactivateNSdu(p_n_sdu);
+        CanTp_ReleaseNSdu(p_n_sdu);
 
-/*-----------------------------------------------------------------------------------------------*/
-/* local function definitions (static).                                                          */
-/*-----------------------------------------------------------------------------------------------*/
+        p_n_sdu = p_next_n_sdu;
+    }
+}
 
-/**
- * @addtogroup CANTP_C_LFDEF
- * @{
- */
+#if (CANTP_TICKLESS_SCHEDULING_API == STD_ON)
 
-static Std_ReturnType CanTp_GetNSduFromPduId(PduIdType pduId, CanTp_NSduType **pNSdu)
+static boolean CanTp_IsNSduPending(const CanTp_NSduType *pNSdu)
 {
-    Std_ReturnType tmp_return = E_NOT_OK;
-    CanTp_NSduType *p_n_sdu;
-    CanTp_ChannelRtType *p_channel_rt;
-    uint32_least channel_idx;
+    const uint32 rx_mask = ((uint32)0x01u << CANTP_I_N_AR) |
+                           ((uint32)0x01u << CANTP_I_N_BR) |
+                           ((uint32)0x01u << CANTP_I_N_CR);
+    const uint32 tx_mask = ((uint32)0x01u << CANTP_I_N_AS) |
+                           ((uint32)0x01u << CANTP_I_N_BS) |
+                           ((uint32)0x01u << CANTP_I_N_CS);
+    boolean result = FALSE;
 
-    for (channel_idx = 0x00u; channel_idx < (uint32_least)CANTP_MAX_NUM_OF_CHANNEL; channel_idx++)
+    if (pNSdu->rx_shared.taskState == CANTP_PROCESSING)
     {
-        p_channel_rt = &CanTp_Rt[channel_idx];
+        if (((pNSdu->timer.expired & rx_mask) != 0x00u) ||
+            ((pNSdu->rx_shared.state == CANTP_RX_FRAME_STATE_FC_TX_REQUEST) &&
+             ((pNSdu->rx->fs != CANTP_FLOW_STATUS_TYPE_WT) ||
+              (CanTp_NetworkLayerIsActive(pNSdu, CANTP_I_N_BR) == FALSE))) ||
+            (pNSdu->rx->retry == TRUE) ||
+            (pNSdu->rx_shared.state == CANTP_FRAME_STATE_OK) ||
+            (pNSdu->rx_shared.state == CANTP_FRAME_STATE_ABORT))
+        {
+            result = TRUE;
+        }
+    }
 
-        if (pduId < (sizeof(p_channel_rt->sdu) / sizeof(p_channel_rt->sdu[0x00u])))
+    if (pNSdu->tx_shared.taskState == CANTP_PROCESSING)
+    {
+        if (((pNSdu->timer.expired & tx_mask) != 0x00u) ||
+            (pNSdu->tx->retry == TRUE) ||
+            (pNSdu->tx_shared.state == CANTP_FRAME_STATE_OK) ||
+            (pNSdu->tx_shared.state == CANTP_FRAME_STATE_ABORT))
+        {
+            result = TRUE;
+        }
+        /* a transmission waiting for CanTp_TxDataAvailable is not polled. */
+        else if ((pNSdu->tx->stall.active == TRUE) &&
+                 (pNSdu->tx->cfg->dataNotification == TRUE) &&
+                 (pNSdu->tx->stall.resume == FALSE))
         {
-            p_n_sdu = &p_channel_rt->sdu[pduId];
+            /* MISRA C, do nothing. */
+        }
+        else if ((pNSdu->tx_shared.state == CANTP_TX_FRAME_STATE_SF_TX_REQUEST) ||
+                 (pNSdu->tx_shared.state == CANTP_TX_FRAME_STATE_FF_TX_REQUEST))
+        {
+            result = TRUE;
+        }
+        /* a CF waiting for STmin is only pending once STmin has elapsed. */
+        else if ((pNSdu->tx_shared.state == CANTP_TX_FRAME_STATE_CF_TX_REQUEST) &&
+                 ((CanTp_NetworkLayerIsActive(pNSdu, CANTP_I_ST_MIN) == FALSE) ||
+                  (CanTp_NetworkLayerTimeoutExpired(pNSdu, CANTP_I_ST_MIN) == TRUE)))
+        {
+            result = TRUE;
+        }
+        else
+        {
+            /* MISRA C, do nothing. */
+        }
+    }
 
-            if (((p_n_sdu->rx.cfg != NULL_PTR) && (p_n_sdu->rx.cfg->nSduId == pduId)) ||
-                ((p_n_sdu->tx.cfg != NULL_PTR) && (p_n_sdu->tx.cfg->nSduId == pduId)))
-            {
-                *pNSdu = p_n_sdu;
-                tmp_return = E_OK;
+    return result;
+}
 
-                break;
-            }
-        }
+static boolean CanTp_IsNSduPolled(const CanTp_NSduType *pNSdu)
+{
+    boolean result = FALSE;
+
+    /* SWS_CanTp_00222: while N_Br is active, the upper layer is polled at each call, unless it
+     * notifies the release of buffer space through CanTp_RxBufferAvailable. */
+    if ((pNSdu->rx_shared.taskState == CANTP_PROCESSING) &&
+        (CanTp_NetworkLayerIsActive(pNSdu, CANTP_I_N_BR) == TRUE) &&
+        (pNSdu->rx->cfg->bufferNotification == FALSE))
+    {
+        result = TRUE;
     }
 
-    return tmp_return;
+    return result;
 }
 
+#endif /* #if (CANTP_TICKLESS_SCHEDULING_API == STD_ON) */
+
 static PduLengthType CanTp_GetRxBlockSize(const CanTp_NSduType *pNSdu)
 {
     PduLengthType result;
-    PduLengthType n_ae_field_size;
-    (void)CanTp_DecodeNAIValue(pNSdu->rx.cfg->af, &n_ae_field_size);
-    const PduLengthType header_size = CANTP_CF_PCI_FIELD_SIZE + n_ae_field_size;
-    const PduLengthType payload_size = CANTP_CAN_FRAME_SIZE - header_size;
-    const PduLengthType full_bs = pNSdu->rx.shared.m_param.bs * payload_size;
-    const PduLengthType last_bs = pNSdu->rx.buf.size;
+    const PduLengthType full_bs = pNSdu->m_param.bs * pNSdu->rx->geometry.cf_dl;
+    const PduLengthType last_bs = pNSdu->rx->buf.size;
 
     if ((last_bs < full_bs) || (full_bs == 0x00u))
     {
         result = last_bs;
     }
-    else
+    else
+    {
+        result = full_bs;
+    }
+
+    return result;
+}
+
+static void CanTp_InitFrameGeometry(CanTp_FrameGeometryType *pGeometry,
+                                    const CanTp_AddressingFormatType af,
+                                    const CanTp_NAeType *pNAe,
+                                    const CanTp_NTaType *pNTa,
+                                    const uint8 dl)
+{
+    PduLengthType n_ae_field_size = 0x00u;
+    PduLengthType ofs = 0x00u;
+
+    pGeometry->af_valid = FALSE;
+    pGeometry->n_ai_valid = FALSE;
+    pGeometry->n_ai_size = 0x00u;
+    pGeometry->n_ai = 0x00u;
+    pGeometry->sf_max_dl = 0x00u;
+    pGeometry->ff_dl = 0x00u;
+    pGeometry->cf_dl = 0x00u;
+
+    if (CanTp_DecodeNAIValue(af, &n_ae_field_size) == E_OK)
+    {
+        pGeometry->af_valid = TRUE;
+        pGeometry->n_ai_size = (uint8)n_ae_field_size;
+
+        if (dl > CANTP_CAN_FRAME_SIZE)
+        {
+            pGeometry->sf_max_dl = dl - (CANTP_SF_ESC_PCI_FIELD_SIZE + n_ae_field_size);
+        }
+        else
+        {
+            pGeometry->sf_max_dl = CANTP_CAN_FRAME_SIZE - (CANTP_SF_PCI_FIELD_SIZE + n_ae_field_size);
+        }
+
+        pGeometry->ff_dl = dl - (CANTP_FF_PCI_FIELD_SIZE + n_ae_field_size);
+        pGeometry->cf_dl = dl - (CANTP_CF_PCI_FIELD_SIZE + n_ae_field_size);
+    }
+
+    if (CanTp_EncodeNAIValue(af, pNAe, pNTa, &pGeometry->n_ai, &ofs) == E_OK)
     {
-        result = full_bs;
+        pGeometry->n_ai_valid = TRUE;
     }
-
-    return result;
 }
 
 static Std_ReturnType CanTp_DecodeNAIValue(const CanTp_AddressingFormatType af,
@@ -2283,6 +4845,92 @@ static PduLengthType CanTp_DecodeDLValue(const CanTp_NPciType frameType,
     return result;
 }
 
+static Std_ReturnType CanTp_CheckRxDLValue(const CanTp_NSduType *pNSdu,
+                                           const PduInfoType *pPduInfo,
+                                           const PduLengthType nAeSize,
+                                           const CanTp_NPciType pci)
+{
+    Std_ReturnType tmp_return = E_OK;
+    PduLengthType header_size;
+    PduLengthType dl;
+    uint32 ff_dl;
+
+    if ((pci == CANTP_N_PCI_TYPE_SF) && (pPduInfo->SduLength > CANTP_CAN_FRAME_SIZE))
+    {
+        /* ISO 15765-2: a SF longer than 8 bytes is ignored if it does not use the SF_DL escape
+         * sequence, or if its SF_DL would fit in a SF without escape sequence. the SF_DL can
+         * neither exceed the payload of the received frame nor the maximum SF_DL of the
+         * configured RX_DL. */
+        header_size = CANTP_SF_ESC_PCI_FIELD_SIZE + nAeSize;
+        dl = (PduLengthType)pPduInfo->SduDataPtr[nAeSize + 0x01u];
+
+        if (((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) != 0x00u) ||
+            (dl <= (CANTP_CAN_FRAME_SIZE - (CANTP_SF_PCI_FIELD_SIZE + nAeSize))) ||
+            (dl > (pPduInfo->SduLength - header_size)) ||
+            (dl > (pNSdu->rx->cfg->rxDl - header_size)))
+        {
+            tmp_return = E_NOT_OK;
+        }
+    }
+    else if (pci == CANTP_N_PCI_TYPE_FF)
+    {
+        /* the largest SF_DL of the RX_DL derived from the CAN_DL of the FF (see SWS_CanTp_00350). */
+        if (pPduInfo->SduLength > CANTP_CAN_FRAME_SIZE)
+        {
+            dl = pPduInfo->SduLength - (CANTP_SF_ESC_PCI_FIELD_SIZE + nAeSize);
+        }
+        else
+        {
+            dl = CANTP_CAN_FRAME_SIZE - (CANTP_SF_PCI_FIELD_SIZE + nAeSize);
+        }
+
+        if (pPduInfo->SduLength < (CANTP_FF_PCI_FIELD_SIZE + nAeSize))
+        {
+            tmp_return = E_NOT_OK;
+        }
+        else if (((pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) == 0x00u) &&
+                 (pPduInfo->SduDataPtr[nAeSize + 0x01u] == 0x00u))
+        {
+            /* ISO 15765-2: a FF using the FF_DL escape sequence is ignored if its FF_DL is lower
+             * than or equal to 4095 bytes. a FF_DL which cannot be represented by PduLengthType is
+             * not supported either. */
+            if (pPduInfo->SduLength < (CANTP_FF_ESC_PCI_FIELD_SIZE + nAeSize))
+            {
+                tmp_return = E_NOT_OK;
+            }
+            else
+            {
+                ff_dl = ((uint32)pPduInfo->SduDataPtr[nAeSize + 0x02u] << 0x18u) |
+                        ((uint32)pPduInfo->SduDataPtr[nAeSize + 0x03u] << 0x10u) |
+                        ((uint32)pPduInfo->SduDataPtr[nAeSize + 0x04u] << 0x08u) |
+                        (uint32)pPduInfo->SduDataPtr[nAeSize + 0x05u];
+
+                if ((ff_dl <= 0x0FFFu) || ((uint32)(PduLengthType)ff_dl != ff_dl))
+                {
+                    tmp_return = E_NOT_OK;
+                }
+            }
+        }
+        /* ISO 15765-2: a FF is ignored if its FF_DL is lower than FF_DLmin, i.e. if the N-SDU fits
+         * in a SF. */
+        else if (((((PduLengthType)pPduInfo->SduDataPtr[nAeSize] & 0x0Fu) << 0x08u) |
+                  (PduLengthType)pPduInfo->SduDataPtr[nAeSize + 0x01u]) <= dl)
+        {
+            tmp_return = E_NOT_OK;
+        }
+        else
+        {
+            /* MISRA C, do nothing. */
+        }
+    }
+    else
+    {
+        /* MISRA C, do nothing. */
+    }
+
+    return tmp_return;
+}
+
 static uint32 CanTp_DecodeSTMinValue(const uint8 data)
 {
     uint32 result;
@@ -2348,11 +4996,11 @@ static void CanTp_AbortRxSession(CanTp_NSduType *pNSdu, const uint8 instanceId,
 
 #endif /* #ifndef CANTP_BUILD_CFFI_INTERFACE */
 
-    pNSdu->rx.shared.taskState = CANTP_WAIT;
+    pNSdu->rx_shared.taskState = CANTP_WAIT;
 
     if (confirm == TRUE)
     {
-        PduR_CanTpRxIndication(pNSdu->rx.cfg->nSduId, E_NOT_OK);
+        PduR_CanTpRxIndication(pNSdu->rx->cfg->nSduId, E_NOT_OK);
     }
 
     if (instanceId != CANTP_I_NONE)
@@ -2366,6 +5014,143 @@ static void CanTp_AbortRxSession(CanTp_NSduType *pNSdu, const uint8 instanceId,
     }
 }
 
+static Std_ReturnType CanTp_GetTxStartState(const CanTp_NSduType *pNSdu,
+                                            const PduLengthType length,
+                                            const uint8 serviceId,
+                                            CanTp_FrameStateType *pState)
+{
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    if (length <= pNSdu->tx->geometry.sf_max_dl)
+    {
+        *pState = CANTP_TX_FRAME_STATE_SF_TX_REQUEST;
+        tmp_return = E_OK;
+    }
+    else
+    {
+        if (pNSdu->tx->cfg->taType == CANTP_PHYSICAL)
+        {
+            *pState = CANTP_TX_FRAME_STATE_FF_TX_REQUEST;
+            tmp_return = E_OK;
+        }
+        else
+        {
+            /* SWS_CanTp_00093: If a multiple segmented session occurs (on both receiver and
+             * sender  side) with a handle whose communication type is functional, the CanTp
+             * module shall reject the request and report the runtime error code
+             * CANTP_E_INVALID_TATYPE to the Default Error Tracer. */
+            CanTp_ReportRuntimeError(0x00u, serviceId, CANTP_E_INVALID_TATYPE);
+        }
+    }
+
+    return tmp_return;
+}
+
+static void CanTp_EndTxStall(CanTp_NSduType *pNSdu)
+{
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
+    uint32 duration;
+
+    if (p_tx->stall.active == TRUE)
+    {
+        duration = CanTp_Now - p_tx->stall.since;
+
+        p_tx->stall.active = FALSE;
+        p_tx->stall.status.total_time += duration;
+
+        if (duration > p_tx->stall.status.max_time)
+        {
+            p_tx->stall.status.max_time = duration;
+        }
+    }
+}
+
+static void CanTp_BeginTxSession(CanTp_NSduType *pNSdu, const CanTp_TxRequestType *pRequest)
+{
+    pNSdu->tx->buf.size = pRequest->length;
+    pNSdu->tx->p_data = pRequest->p_data;
+    pNSdu->tx->in_flight_cnt = 0x00u;
+    pNSdu->tx->in_flight_idx = 0x00u;
+    pNSdu->tx->retry = FALSE;
+    pNSdu->tx->buf.rmng = 0x00u;
+    pNSdu->tx->staging.ofs = 0x00u;
+    pNSdu->tx->staging.cnt = 0x00u;
+    pNSdu->tx_shared.state = pRequest->state;
+    pNSdu->tx_shared.taskState = CANTP_PROCESSING;
+}
+
+static Std_ReturnType CanTp_EnqueueTxRequest(CanTp_NSduType *pNSdu,
+                                             const CanTp_TxRequestType *pRequest)
+{
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
+    uint32 idx;
+    Std_ReturnType tmp_return = E_NOT_OK;
+
+    CANTP_ENTER_CRITICAL_SECTION
+
+    if (p_tx->queue.status.pending < p_tx->cfg->txQueueDepth)
+    {
+        idx = ((uint32)p_tx->queue.head + p_tx->queue.status.pending) % p_tx->cfg->txQueueDepth;
+        p_tx->queue.p_request[idx] = *pRequest;
+        p_tx->queue.status.pending++;
+        p_tx->queue.status.enqueued++;
+
+        tmp_return = E_OK;
+    }
+    else
+    {
+        p_tx->queue.status.rejected++;
+    }
+
+    CANTP_EXIT_CRITICAL_SECTION
+
+    if (tmp_return == E_OK)
+    {
+        /* the ongoing session may have ended since the caller checked it. */
+        (void)CanTp_StartNextTxRequest(pNSdu);
+    }
+
+    return tmp_return;
+}
+
+static boolean CanTp_StartNextTxRequest(CanTp_NSduType *pNSdu)
+{
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
+    boolean started = FALSE;
+
+    if ((p_tx->queue.status.pending > 0x00u) && (pNSdu->tx_shared.taskState != CANTP_PROCESSING))
+    {
+        /* the timers of the previous session (which may have been aborted on a timeout) must not
+         * affect the new one. */
+        CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_N_AS);
+        CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_N_BS);
+        CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_N_CS);
+        CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_ST_MIN);
+
+        CANTP_ENTER_CRITICAL_SECTION
+
+        if ((p_tx->queue.status.pending > 0x00u) && (pNSdu->tx_shared.taskState != CANTP_PROCESSING))
+        {
+            CanTp_BeginTxSession(pNSdu, &p_tx->queue.p_request[p_tx->queue.head]);
+
+            p_tx->queue.head = (uint8)((p_tx->queue.head + 0x01u) % p_tx->cfg->txQueueDepth);
+            p_tx->queue.status.pending--;
+            p_tx->queue.status.dequeued++;
+
+            started = TRUE;
+        }
+
+        CANTP_EXIT_CRITICAL_SECTION
+
+        if (started == TRUE)
+        {
+            CanTp_ActivateNSdu(pNSdu);
+        }
+    }
+
+    return started;
+}
+
 static void CanTp_AbortTxSession(CanTp_NSduType *pNSdu, const uint8 instanceId, boolean confirm)
 {
 
@@ -2375,149 +5160,346 @@ static void CanTp_AbortTxSession(CanTp_NSduType *pNSdu, const uint8 instanceId,
 
 #endif /* #ifndef CANTP_BUILD_CFFI_INTERFACE */
 
-    pNSdu->tx.taskState = CANTP_WAIT;
+    pNSdu->tx_shared.taskState = CANTP_WAIT;
+
+    CanTp_EndTxStall(pNSdu);
 
     if (confirm == TRUE)
     {
-        PduR_CanTpTxConfirmation(pNSdu->tx.cfg->nSduId, E_NOT_OK);
+        PduR_CanTpTxConfirmation(pNSdu->tx->cfg->nSduId, E_NOT_OK);
+    }
+
+    if (instanceId != CANTP_I_NONE)
+    {
+        /* SWS_CanTp_00229 if the task was aborted due to As, Bs, Cs, Ar, Br, Cr timeout, the CanTp
+         * module shall raise the DET error CANTP_E_RX_COM (in case of a reception operation) or
+         * CANTP_E_TX_COM (in case of a transmission operation). If the task was aborted due to any
+         * other protocol error, the CanTp module shall raise the runtime error code CANTP_E_COM to
+         * the Default Error Tracer. */
+        CanTp_ReportError(instanceId, 0x00u, CANTP_E_TX_COM);
+    }
+
+    (void)CanTp_StartNextTxRequest(pNSdu);
+}
+
+static Std_ReturnType CanTp_TransmitNPdu(CanTp_NSduType *pNSdu,
+                                         PduIdType txPduId,
+                                         const PduInfoType *pPduInfo)
+{
+    CanTp_PeerType *p_peer = pNSdu->p_peer;
+    Std_ReturnType tmp_return = E_NOT_OK;
+    boolean recorded = FALSE;
+
+    if (p_peer != NULL_PTR)
+    {
+        /* the N-PDU is recorded before calling CanIf, which may confirm it right away. it is
+         * deferred if another entry bound to the same N-SDU waits for a confirmation. */
+        CANTP_ENTER_CRITICAL_SECTION
+
+        if ((p_peer->p_template->p_unconfirmed == NULL_PTR) ||
+            (p_peer->p_template->p_unconfirmed == p_peer))
+        {
+            p_peer->p_template->p_unconfirmed = p_peer;
+            p_peer->pending++;
+            recorded = TRUE;
+        }
+
+        p_peer->deferred = (boolean)(recorded != TRUE);
+
+        CANTP_EXIT_CRITICAL_SECTION
+    }
+
+    if ((p_peer == NULL_PTR) || (recorded == TRUE))
+    {
+        tmp_return = CanIf_Transmit(txPduId, pPduInfo);
+    }
+
+    if ((tmp_return != E_OK) && (recorded == TRUE))
+    {
+        CANTP_ENTER_CRITICAL_SECTION
+
+        if ((p_peer->p_template->p_unconfirmed == p_peer) && (p_peer->pending > 0x00u))
+        {
+            p_peer->pending--;
+
+            if (p_peer->pending == 0x00u)
+            {
+                p_peer->p_template->p_unconfirmed = NULL_PTR;
+            }
+        }
+
+        CANTP_EXIT_CRITICAL_SECTION
+    }
+
+    return tmp_return;
+}
+
+static Std_ReturnType CanTp_TransmitRxCANData(CanTp_NSduType *pNSdu)
+{
+    Std_ReturnType tmp_return;
+
+    CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_N_AR);
+
+    tmp_return = CanTp_TransmitNPdu(pNSdu, pNSdu->rx->cfg->rxNSduRef, &pNSdu->rx->can_if_pdu_info);
+
+    /* non-standard: a FC(CTS/WAIT) rejected by CanIf, or deferred by a connection pool entry, is
+     * transmitted again until N_Ar expires. a FC(OVFLW) is not, as the reception is terminated
+     * right after it. */
+    if ((tmp_return != E_OK) &&
+        ((pNSdu->rx->cfg->transmitRetry == TRUE) ||
+         ((pNSdu->p_peer != NULL_PTR) && (pNSdu->p_peer->deferred == TRUE))) &&
+        (pNSdu->rx_shared.state == CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION))
+    {
+        pNSdu->rx->retry = TRUE;
+        tmp_return = E_OK;
+    }
+
+    return tmp_return;
+}
+
+static void CanTp_TransmitTxCANData(CanTp_NSduType *pNSdu)
+{
+    CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_N_AS);
+
+    if (CanTp_TransmitNPdu(pNSdu, (PduIdType)pNSdu->tx->cfg->txNSduRef, &pNSdu->tx->can_if_pdu_info) != E_OK)
+    {
+        if ((pNSdu->tx->cfg->transmitRetry == TRUE) ||
+            ((pNSdu->p_peer != NULL_PTR) && (pNSdu->p_peer->deferred == TRUE)))
+        {
+            /* non-standard: the N-PDU is transmitted again until N_As expires. */
+            pNSdu->tx->retry = TRUE;
+        }
+        else
+        {
+            /* SWS_CanTp_00343 CanTp shall terminate the current transmission connection when
+             * CanIf_Transmit() returns E_NOT_OK when transmitting an SF, FF, of CF. */
+            CanTp_AbortTxSession(pNSdu, CANTP_I_NONE, FALSE);
+        }
+    }
+}
+
+static void CanTp_RetryRxCANData(CanTp_NSduType *pNSdu)
+{
+    if (CanTp_TransmitNPdu(pNSdu, pNSdu->rx->cfg->rxNSduRef, &pNSdu->rx->can_if_pdu_info) == E_OK)
+    {
+        pNSdu->rx->retry = FALSE;
+    }
+}
+
+static void CanTp_RetryTxCANData(CanTp_NSduType *pNSdu)
+{
+    if (CanTp_TransmitNPdu(pNSdu, (PduIdType)pNSdu->tx->cfg->txNSduRef, &pNSdu->tx->can_if_pdu_info) == E_OK)
+    {
+        pNSdu->tx->retry = FALSE;
+    }
+}
+
+static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    const CanTp_StateHandlerType *p_handler;
+
+    if ((CanTp_NetworkLayerIsActive(p_n_sdu, CANTP_I_N_BR) == TRUE) &&
+        (p_n_sdu->rx->cfg->bufferNotification == FALSE))
+    {
+        /* SWS_CanTp_00222: wWhile the timer N_Br is active, the CanTp module shall call the service
+         * PduR_CanTpCopyRxData() with a data length 0 (zero) and NULL_PTR as data buffer during
+         * each processing of the MainFunction. */
+        p_n_sdu->rx->pdu_r_pdu_info.SduLength = 0x00u;
+        p_n_sdu->rx->pdu_r_pdu_info.SduDataPtr = NULL_PTR;
+        /* TODO: check if the PduR_CanTpCopyRxData might return something else than BUFREQ_OK... */
+        (void)CanTp_CopyRxPayload(p_n_sdu);
+    }
+
+    if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_BR) == TRUE)
+    {
+        CanTp_ReportError(CANTP_I_N_BR, 0x00u, CANTP_E_RX_COM);
+    }
+
+    if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_AR) == TRUE)
+    {
+        CanTp_AbortRxSession(pNSdu, CANTP_I_N_AR, TRUE);
+    }
+    else if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_CR) == TRUE)
+    {
+        CanTp_AbortRxSession(pNSdu, CANTP_I_N_CR, TRUE);
+    }
+    else if (p_n_sdu->rx->retry == TRUE)
+    {
+        CanTp_RetryRxCANData(p_n_sdu);
+    }
+    else
+    {
+        p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_RX, p_n_sdu->rx_shared.state);
+
+        if (p_handler->mainFunction != NULL_PTR)
+        {
+            p_handler->mainFunction(p_n_sdu);
+        }
     }
+}
+
+static void CanTp_PerformStepRxOK(CanTp_NSduType *pNSdu)
+{
+    pNSdu->rx_shared.taskState = CANTP_WAIT;
+}
+
+static void CanTp_PerformStepRxAbort(CanTp_NSduType *pNSdu)
+{
+    CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, FALSE);
+}
+
+static void CanTp_PerformStepRxFC(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
+
+    p_n_sdu->rx_shared.state = CanTp_LDataReqRFC(p_n_sdu);
+
+    switch (p_n_sdu->rx_shared.state)
+    {
+        case CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION:
+        {
+            if (CanTp_TransmitRxCANData(p_n_sdu) != E_OK)
+            {
+                /* SWS_CanTp_00342 CanTp shall terminate the current reception connection when
+                 * CanIf_Transmit() returns E_NOT_OK when transmitting an FC. */
+                CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, FALSE);
+            }
+
+            break;
+        }
+        case CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION:
+        {
+            if (CanTp_TransmitRxCANData(p_n_sdu) != E_OK)
+            {
+                /* SWS_CanTp_00342 CanTp shall terminate the current reception connection when
+                 * CanIf_Transmit() returns E_NOT_OK when transmitting an FC. */
+                CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, FALSE);
+            }
+            else
+            {
+                CanTp_AbortRxSession(pNSdu, CANTP_I_N_BUFFER_OVFLW, FALSE);
+            }
+
+            break;
+        }
+        case CANTP_FRAME_STATE_ABORT:
+        {
+            CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, TRUE);
 
-    if (instanceId != CANTP_I_NONE)
-    {
-        /* SWS_CanTp_00229 if the task was aborted due to As, Bs, Cs, Ar, Br, Cr timeout, the CanTp
-         * module shall raise the DET error CANTP_E_RX_COM (in case of a reception operation) or
-         * CANTP_E_TX_COM (in case of a transmission operation). If the task was aborted due to any
-         * other protocol error, the CanTp module shall raise the runtime error code CANTP_E_COM to
-         * the Default Error Tracer. */
-        CanTp_ReportError(instanceId, 0x00u, CANTP_E_TX_COM);
+            break;
+        }
+        default:
+        {
+            break;
+        }
     }
 }
 
-static Std_ReturnType CanTp_TransmitRxCANData(CanTp_NSduType *pNSdu)
+static void CanTp_PerformStepTxCF(CanTp_NSduType *pNSdu)
 {
-    CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_N_AR);
+    CanTp_NSduType *p_n_sdu = pNSdu;
+
+    if ((CanTp_FlowControlExpired(p_n_sdu) == TRUE) ||
+        (CanTp_FlowControlActive(p_n_sdu) == FALSE))
+    {
+        p_n_sdu->tx_shared.state = CanTp_LDataReqTCF(p_n_sdu);
+
+        if (p_n_sdu->tx_shared.state == CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION)
+        {
+            p_n_sdu->tx->burst_cnt++;
 
-    return CanIf_Transmit(pNSdu->rx.cfg->rxNSduRef, &pNSdu->rx.can_if_pdu_info);
+            CanTp_TransmitTxCF(p_n_sdu);
+            CanTp_FillTxWindow(p_n_sdu);
+        }
+    }
 }
 
-static void CanTp_TransmitTxCANData(CanTp_NSduType *pNSdu)
+static void CanTp_TransmitTxCF(CanTp_NSduType *pNSdu)
 {
-    CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_N_AS);
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
 
-    if (CanIf_Transmit((PduIdType)pNSdu->tx.cfg->txNSduRef, &pNSdu->tx.can_if_pdu_info) != E_OK)
+    /* the transmission time is only needed to restart N_As for the next CF in flight. */
+    if (p_tx->p_sent_at != NULL_PTR)
     {
-        /* SWS_CanTp_00343 CanTp shall terminate the current transmission connection when
-         * CanIf_Transmit() returns E_NOT_OK when transmitting an SF, FF, of CF. */
-        CanTp_AbortTxSession(pNSdu, CANTP_I_NONE, FALSE);
+        p_tx->p_sent_at[(p_tx->in_flight_idx + p_tx->in_flight_cnt) % p_tx->cfg->txWindow] = CanTp_Now;
     }
+
+    p_tx->in_flight_cnt++;
+
+    CanTp_TransmitTxCANData(pNSdu);
 }
 
-static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu)
+static void CanTp_ReleaseTxCF(CanTp_NSduType *pNSdu)
 {
-    CanTp_NSduType *p_n_sdu = pNSdu;
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
+    uint32 elapsed;
+    uint32 timeout;
 
-    if (CanTp_NetworkLayerIsActive(p_n_sdu, CANTP_I_N_BR) == TRUE)
-    {
-        /* SWS_CanTp_00222: wWhile the timer N_Br is active, the CanTp module shall call the service
-         * PduR_CanTpCopyRxData() with a data length 0 (zero) and NULL_PTR as data buffer during
-         * each processing of the MainFunction. */
-        p_n_sdu->rx.pdu_r_pdu_info.SduLength = 0x00u;
-        p_n_sdu->rx.pdu_r_pdu_info.SduDataPtr = NULL_PTR;
-        /* TODO: check if the PduR_CanTpCopyRxData might return something else than BUFREQ_OK... */
-        (void)CanTp_CopyRxPayload(p_n_sdu);
-    }
+    CanTp_StopNetworkLayerTimeout(pNSdu, CANTP_I_N_AS);
 
-    if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_BR) == TRUE)
+    if (p_tx->in_flight_cnt > 0x00u)
     {
-        CanTp_ReportError(CANTP_I_N_BR, 0x00u, CANTP_E_RX_COM);
-    }
+        p_tx->in_flight_cnt--;
 
-    if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_AR) == TRUE)
-    {
-        CanTp_AbortRxSession(pNSdu, CANTP_I_N_AR, TRUE);
-    }
-    else if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_CR) == TRUE)
-    {
-        CanTp_AbortRxSession(pNSdu, CANTP_I_N_CR, TRUE);
-    }
-    else
-    {
-        switch (p_n_sdu->rx.shared.state)
+        if (p_tx->p_sent_at != NULL_PTR)
         {
-            case CANTP_RX_FRAME_STATE_FC_TX_REQUEST:
-            {
-                p_n_sdu->rx.shared.state = CanTp_LDataReqRFC(p_n_sdu);
+            p_tx->in_flight_idx = (uint8)((p_tx->in_flight_idx + 0x01u) % p_tx->cfg->txWindow);
+        }
+    }
 
-                switch (p_n_sdu->rx.shared.state)
-                {
-                    case CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION:
-                    {
-                        if (CanTp_TransmitRxCANData(p_n_sdu) != E_OK)
-                        {
-                            /* SWS_CanTp_00342 CanTp shall terminate the current reception
-                             * connection when CanIf_Transmit() returns E_NOT_OK when transmitting
-                             * an FC. */
-                            CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, FALSE);
-                        }
+    /* CanIf confirms the frames in the order they have been transmitted: N_As is now observed for
+     * the next CF, from the time it has been handed over to CanIf. */
+    if ((p_tx->in_flight_cnt > 0x00u) && (p_tx->p_sent_at != NULL_PTR))
+    {
+        elapsed = CanTp_Now - p_tx->p_sent_at[p_tx->in_flight_idx];
+        timeout = CanTp_GetTimeout(pNSdu, CANTP_I_N_AS);
 
-                        break;
-                    }
-                    case CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION:
-                    {
-                        if (CanTp_TransmitRxCANData(p_n_sdu) != E_OK)
-                        {
-                            /* SWS_CanTp_00342 CanTp shall terminate the current reception
-                             * connection when CanIf_Transmit() returns E_NOT_OK when transmitting
-                             * an FC. */
-                            CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, FALSE);
-                        }
-                        else
-                        {
-                            CanTp_AbortRxSession(pNSdu, CANTP_I_N_BUFFER_OVFLW, FALSE);
-                        }
+        if (elapsed < timeout)
+        {
+            CanTp_StartTimer(pNSdu, CANTP_I_N_AS, timeout - elapsed);
+        }
+        else
+        {
+            CanTp_StartTimer(pNSdu, CANTP_I_N_AS, 0x00u);
+        }
+    }
+}
 
-                        break;
-                    }
-                    case CANTP_FRAME_STATE_ABORT:
-                    {
-                        CanTp_AbortRxSession(pNSdu, CANTP_I_NONE, TRUE);
+static void CanTp_FillTxWindow(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
+    CanTp_TxConnectionType *p_tx = p_n_sdu->tx;
+    CanTp_FrameStateType next_state;
+    boolean open = TRUE;
 
-                        break;
-                    }
-                    default:
-                    {
-                        break;
-                    }
-                }
+    while (open == TRUE)
+    {
+        open = FALSE;
+
+        if ((p_n_sdu->tx_shared.taskState == CANTP_PROCESSING) &&
+            (p_n_sdu->tx_shared.state == CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION) &&
+            (p_tx->target_st_min == 0x00u) &&
+            (p_tx->retry == FALSE) &&
+            (p_tx->in_flight_cnt < p_tx->cfg->txWindow) &&
+            (p_tx->buf.size > 0x00u) &&
+            ((p_tx->bs == CANTP_BS_INFINITE) || (p_tx->in_flight_cnt < p_tx->bs)))
+        {
+            next_state = CanTp_LDataReqTCF(p_n_sdu);
 
-                break;
-            }
-            case CANTP_FRAME_STATE_ABORT:
+            if (next_state == CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION)
             {
-                CanTp_AbortRxSession(p_n_sdu, CANTP_I_NONE, FALSE);
-
-                break;
+                CanTp_TransmitTxCF(p_n_sdu);
+                open = TRUE;
             }
-            case CANTP_FRAME_STATE_OK:
+            else if (next_state == CANTP_FRAME_STATE_ABORT)
             {
-                p_n_sdu->rx.shared.taskState = CANTP_WAIT;
-
-                break;
+                p_n_sdu->tx_shared.state = next_state;
             }
-            case CANTP_FRAME_STATE_INVALID:
-            case CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION:
-            case CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION:
-            case CANTP_RX_FRAME_STATE_CF_RX_INDICATION:
-            case CANTP_TX_FRAME_STATE_SF_TX_REQUEST:
-            case CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_FF_TX_REQUEST:
-            case CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_CF_TX_REQUEST:
-            case CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_FC_RX_INDICATION:
-            default:
+            else
             {
-                break;
+                /* the payload of the next CF is not available yet: the CFs in flight are still
+                 * waiting for their confirmation, which retries to fill the window. */
             }
         }
     }
@@ -2526,6 +5508,10 @@ static void CanTp_PerformStepRx(CanTp_NSduType *pNSdu)
 static void CanTp_PerformStepTx(CanTp_NSduType *pNSdu)
 {
     CanTp_NSduType *p_n_sdu = pNSdu;
+    const CanTp_StateHandlerType *p_handler;
+
+    /* a new period begins, the CF burst budget of this N-SDU is restored. */
+    p_n_sdu->tx->burst_cnt = 0x00u;
 
     if (CanTp_NetworkLayerTimeoutExpired(p_n_sdu, CANTP_I_N_AS) == TRUE)
     {
@@ -2545,92 +5531,263 @@ static void CanTp_PerformStepTx(CanTp_NSduType *pNSdu)
          * PduR_CanTpTxConfirmation with the result E_NOT_OK. */
         CanTp_AbortTxSession(p_n_sdu, CANTP_I_N_CS, TRUE);
     }
+    else if (p_n_sdu->tx->retry == TRUE)
+    {
+        CanTp_RetryTxCANData(p_n_sdu);
+    }
+    else if ((p_n_sdu->tx->stall.active == TRUE) &&
+             (p_n_sdu->tx->cfg->dataNotification == TRUE) &&
+             (p_n_sdu->tx->stall.resume == FALSE))
+    {
+        /* the upper layer is not polled, the transmission is resumed by CanTp_TxDataAvailable. */
+    }
     else
     {
-        switch (p_n_sdu->tx.shared.state)
+        /* a notification received from now on applies to the next request of the payload. */
+        CANTP_ENTER_CRITICAL_SECTION
+        p_n_sdu->tx->stall.resume = FALSE;
+        CANTP_EXIT_CRITICAL_SECTION
+
+        p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_TX, p_n_sdu->tx_shared.state);
+
+        if (p_handler->mainFunction != NULL_PTR)
         {
-            case CANTP_TX_FRAME_STATE_SF_TX_REQUEST:
-            {
-                p_n_sdu->tx.shared.state = CanTp_LDataReqTSF(p_n_sdu);
+            p_handler->mainFunction(p_n_sdu);
+        }
+    }
+}
 
-                if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION)
-                {
-                    CanTp_TransmitTxCANData(p_n_sdu);
-                }
+static void CanTp_PerformStepTxSF(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
 
-                break;
-            }
-            case CANTP_TX_FRAME_STATE_FF_TX_REQUEST:
-            {
-                p_n_sdu->tx.shared.state = CanTp_LDataReqTFF(p_n_sdu);
+    p_n_sdu->tx_shared.state = CanTp_LDataReqTSF(p_n_sdu);
 
-                if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION)
-                {
-                    CanTp_TransmitTxCANData(p_n_sdu);
-                }
+    if (p_n_sdu->tx_shared.state == CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION)
+    {
+        CanTp_TransmitTxCANData(p_n_sdu);
+    }
+}
 
-                break;
-            }
-            case CANTP_TX_FRAME_STATE_CF_TX_REQUEST:
+static void CanTp_PerformStepTxFF(CanTp_NSduType *pNSdu)
+{
+    CanTp_NSduType *p_n_sdu = pNSdu;
+
+    p_n_sdu->tx_shared.state = CanTp_LDataReqTFF(p_n_sdu);
+
+    if (p_n_sdu->tx_shared.state == CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION)
+    {
+        CanTp_TransmitTxCANData(p_n_sdu);
+    }
+}
+
+static void CanTp_PerformStepTxOK(CanTp_NSduType *pNSdu)
+{
+    const CanTp_StateHandlerType *p_handler;
+
+    /* SWS_CanTp_00090: when the transport transmission session is successfully completed, the
+     * CanTp module shall call a notification service of the upper layer,
+     * PduR_CanTpTxConfirmation(), with the result E_OK. */
+    PduR_CanTpTxConfirmation(pNSdu->tx->cfg->nSduId, E_OK);
+
+    pNSdu->tx_shared.taskState = CANTP_WAIT;
+
+    /* the first frame of the next queued request is transmitted during the same period. */
+    if (CanTp_StartNextTxRequest(pNSdu) == TRUE)
+    {
+        p_handler = CanTp_GetStateHandler(CANTP_DIRECTION_TX, pNSdu->tx_shared.state);
+
+        if (p_handler->mainFunction != NULL_PTR)
+        {
+            p_handler->mainFunction(pNSdu);
+        }
+    }
+}
+
+static void CanTp_PerformStepTxAbort(CanTp_NSduType *pNSdu)
+{
+    CanTp_AbortTxSession(pNSdu, CANTP_I_NONE, FALSE);
+}
+
+static const CanTp_StateHandlerType *CanTp_GetStateHandler(const uint8 direction,
+                                                           const CanTp_FrameStateType state)
+{
+    const CanTp_StateHandlerType *p_table = &CanTp_TxStateHandler[0x00u];
+    CanTp_FrameStateType valid_state = CANTP_FRAME_STATE_INVALID;
+
+    if (direction == CANTP_DIRECTION_RX)
+    {
+        p_table = &CanTp_RxStateHandler[0x00u];
+    }
+
+    if ((uint8)state < CANTP_FRAME_STATE_CNT)
+    {
+        valid_state = state;
+    }
+
+    CANTP_STATE_HANDLER_HOOK(direction, valid_state)
+
+    return &p_table[valid_state];
+}
+
+static BufReq_ReturnType CanTp_CopyRxPayload(CanTp_NSduType *pNSdu)
+{
+    BufReq_ReturnType result = BUFREQ_E_NOT_OK;
+    PduLengthType idx;
+    const PduInfoType *p_pdu_info = &pNSdu->rx->pdu_r_pdu_info;
+
+    if (pNSdu->rx->dst.p_data != NULL_PTR)
+    {
+        /* the payload is written directly into the buffer registered by the upper layer, which
+         * only gets notified of the complete N-SDU by PduR_CanTpRxIndication. */
+        if (p_pdu_info->SduLength <= pNSdu->rx->dst.size)
+        {
+            for (idx = 0x00u; idx < p_pdu_info->SduLength; idx++)
             {
-                if ((CanTp_FlowControlExpired(p_n_sdu) == TRUE) ||
-                    (CanTp_FlowControlActive(p_n_sdu) == FALSE))
-                {
-                    p_n_sdu->tx.shared.state = CanTp_LDataReqTCF(p_n_sdu);
+                pNSdu->rx->dst.p_data[idx] = p_pdu_info->SduDataPtr[idx];
+            }
 
-                    if (p_n_sdu->tx.shared.state == CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION)
-                    {
-                        CanTp_TransmitTxCANData(p_n_sdu);
-                    }
-                }
+            pNSdu->rx->dst.p_data = &pNSdu->rx->dst.p_data[p_pdu_info->SduLength];
+            pNSdu->rx->dst.size -= p_pdu_info->SduLength;
 
-                break;
+            if (pNSdu->rx->buf.rmng > p_pdu_info->SduLength)
+            {
+                pNSdu->rx->buf.rmng -= p_pdu_info->SduLength;
             }
-            case CANTP_FRAME_STATE_ABORT:
+            else
             {
-                CanTp_AbortTxSession(p_n_sdu, CANTP_I_NONE, FALSE);
-
-                break;
+                pNSdu->rx->buf.rmng = 0x00u;
             }
-            case CANTP_FRAME_STATE_OK:
+
+            result = BUFREQ_OK;
+        }
+    }
+    else if ((pNSdu->rx->cfg->rxStagingSize > 0x00u) && (p_pdu_info->SduLength > 0x00u))
+    {
+        /* the payload is accumulated in the staging buffer, the upper layer is notified by @ref
+         * CanTp_FlushRxPayload at the end of each block and at the end of the reception, or here
+         * if the staging buffer cannot hold the payload of this frame. */
+        result = BUFREQ_OK;
+
+        if ((pNSdu->rx->staging.cnt + p_pdu_info->SduLength) > pNSdu->rx->cfg->rxStagingSize)
+        {
+            result = CanTp_FlushRxPayload(pNSdu);
+        }
+
+        if (result == BUFREQ_OK)
+        {
+            for (idx = 0x00u; idx < p_pdu_info->SduLength; idx++)
             {
-                /* SWS_CanTp_00090: when the transport transmission session is successfully
-                 * completed, the CanTp module shall call a notification service of the upper layer,
-                 * PduR_CanTpTxConfirmation(), with the result E_OK. */
-                PduR_CanTpTxConfirmation(p_n_sdu->tx.cfg->nSduId, E_OK);
+                pNSdu->rx->staging.p_data[pNSdu->rx->staging.cnt + idx] = p_pdu_info->SduDataPtr[idx];
+            }
 
-                p_n_sdu->tx.taskState = CANTP_WAIT;
+            pNSdu->rx->staging.cnt += (uint16)p_pdu_info->SduLength;
 
-                break;
+            if (pNSdu->rx->buf.rmng > p_pdu_info->SduLength)
+            {
+                pNSdu->rx->buf.rmng -= p_pdu_info->SduLength;
             }
-            case CANTP_FRAME_STATE_INVALID:
-            case CANTP_RX_FRAME_STATE_CF_RX_INDICATION:
-            case CANTP_RX_FRAME_STATE_FC_TX_REQUEST:
-            case CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION:
-            case CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION:
-            case CANTP_TX_FRAME_STATE_FC_RX_INDICATION:
-            case CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION:
-            default:
+            else
             {
-                break;
+                pNSdu->rx->buf.rmng = 0x00u;
             }
         }
     }
+    else
+    {
+        result = PduR_CanTpCopyRxData(pNSdu->rx->cfg->nSduId, p_pdu_info, &pNSdu->rx->buf.rmng);
+    }
+
+    if (result == BUFREQ_OK)
+    {
+        pNSdu->rx->buf.size -= p_pdu_info->SduLength;
+    }
+
+    return result;
 }
 
-static BufReq_ReturnType CanTp_CopyRxPayload(CanTp_NSduType *pNSdu)
+static BufReq_ReturnType CanTp_FlushRxPayload(CanTp_NSduType *pNSdu)
 {
-    BufReq_ReturnType result;
+    BufReq_ReturnType result = BUFREQ_OK;
+    PduInfoType tmp_pdu;
+
+    if (pNSdu->rx->staging.cnt != 0x00u)
+    {
+        tmp_pdu.SduDataPtr = pNSdu->rx->staging.p_data;
+        tmp_pdu.SduLength = pNSdu->rx->staging.cnt;
+        tmp_pdu.MetaDataPtr = CanTp_GetRxMetaData(pNSdu);
+
+        pNSdu->rx->staging.cnt = 0x00u;
+
+        result = PduR_CanTpCopyRxData(pNSdu->rx->cfg->nSduId, &tmp_pdu, &pNSdu->rx->buf.rmng);
+    }
+
+    return result;
+}
+
+static BufReq_ReturnType CanTp_CopyTxStagedPayload(CanTp_NSduType *pNSdu, const PduInfoType *pPduInfo)
+{
+    CanTp_TxConnectionType *p_tx = pNSdu->tx;
+    BufReq_ReturnType result = BUFREQ_OK;
+    PduInfoType tmp_pdu;
+    PduLengthType size;
+    PduLengthType idx;
+
+    if (p_tx->staging.cnt < pPduInfo->SduLength)
+    {
+        /* the bytes left from the previous request (less than a frame) are moved to the beginning
+         * of the staging buffer, so that the upper layer always copies into contiguous memory. */
+        for (idx = 0x00u; idx < p_tx->staging.cnt; idx++)
+        {
+            p_tx->staging.p_data[idx] = p_tx->staging.p_data[p_tx->staging.ofs + idx];
+        }
+
+        p_tx->staging.ofs = 0x00u;
+
+        /* as much of the remaining payload as the staging buffer can hold is requested (e.g. a
+         * whole block after a FC(CTS)), but not more than the upper layer reported as available,
+         * unless the frame itself needs more. */
+        size = p_tx->cfg->txStagingSize - p_tx->staging.cnt;
+
+        if (size > (p_tx->buf.size - p_tx->staging.cnt))
+        {
+            size = p_tx->buf.size - p_tx->staging.cnt;
+        }
+
+        if (p_tx->buf.rmng < size)
+        {
+            size = p_tx->buf.rmng;
+
+            if (size < (pPduInfo->SduLength - p_tx->staging.cnt))
+            {
+                size = pPduInfo->SduLength - p_tx->staging.cnt;
+            }
+        }
+
+        tmp_pdu.SduDataPtr = &p_tx->staging.p_data[p_tx->staging.cnt];
+        tmp_pdu.SduLength = size;
+        tmp_pdu.MetaDataPtr = CanTp_GetTxMetaData(pNSdu);
 
-    result = PduR_CanTpCopyRxData(pNSdu->rx.cfg->nSduId,
-                                  &pNSdu->rx.pdu_r_pdu_info,
-                                  &pNSdu->rx.buf.rmng);
+        CanTp_StartNetworkLayerTimeout(pNSdu, CANTP_I_N_CS);
+
+        /* SWS_CanTp_00272: see CanTp_CopyTxPayload. */
+        result = PduR_CanTpCopyTxData(p_tx->cfg->nSduId, &tmp_pdu, NULL_PTR, &p_tx->buf.rmng);
+
+        if (result == BUFREQ_OK)
+        {
+            p_tx->staging.cnt += (uint16)size;
+        }
+    }
 
     if (result == BUFREQ_OK)
     {
-        pNSdu->rx.buf.size -= pNSdu->rx.pdu_r_pdu_info.SduLength;
+        for (idx = 0x00u; idx < pPduInfo->SduLength; idx++)
+        {
+            pPduInfo->SduDataPtr[idx] = p_tx->staging.p_data[p_tx->staging.ofs + idx];
+        }
+
+        p_tx->staging.ofs += (uint16)pPduInfo->SduLength;
+        p_tx->staging.cnt -= (uint16)pPduInfo->SduLength;
     }
 
     return result;
@@ -2641,34 +5798,57 @@ static BufReq_ReturnType CanTp_CopyTxPayload(CanTp_NSduType *pNSdu, PduLengthTyp
     BufReq_ReturnType result;
     PduInfoType tmp_pdu;
     PduLengthType ofs = *pOfs;
+    PduLengthType idx;
     CanTp_NSduType *p_n_sdu = pNSdu;
-    tmp_pdu.SduDataPtr = &p_n_sdu->tx.buf.can[ofs];
+    tmp_pdu.SduDataPtr = &p_n_sdu->tx->buf.can[ofs];
+    tmp_pdu.MetaDataPtr = CanTp_GetTxMetaData(p_n_sdu);
 
-    if (p_n_sdu->tx.buf.size <= (CANTP_CAN_FRAME_SIZE - ofs))
+    if (p_n_sdu->tx->buf.size <= (p_n_sdu->tx->cfg->txDl - ofs))
     {
-        tmp_pdu.SduLength = p_n_sdu->tx.buf.size;
+        tmp_pdu.SduLength = p_n_sdu->tx->buf.size;
     }
     else
     {
-        tmp_pdu.SduLength = CANTP_CAN_FRAME_SIZE - ofs;
+        tmp_pdu.SduLength = p_n_sdu->tx->cfg->txDl - ofs;
     }
 
-    CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CS);
+    if (p_n_sdu->tx->p_data != NULL_PTR)
+    {
+        /* the payload has been provided by @ref CanTp_TransmitBuffer: it is sliced directly from
+         * the caller buffer, the upper layer is not involved. */
+        for (idx = 0x00u; idx < tmp_pdu.SduLength; idx++)
+        {
+            tmp_pdu.SduDataPtr[idx] = p_n_sdu->tx->p_data[idx];
+        }
+
+        p_n_sdu->tx->p_data = &p_n_sdu->tx->p_data[tmp_pdu.SduLength];
+
+        result = BUFREQ_OK;
+    }
+    else if (p_n_sdu->tx->cfg->txStagingSize > 0x00u)
+    {
+        result = CanTp_CopyTxStagedPayload(p_n_sdu, &tmp_pdu);
+    }
+    else
+    {
+        CanTp_StartNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CS);
 
-    /* SWS_CanTp_00272: the API PduR_CanTpCopyTxData() contains a parameter used for the recovery
-     * mechanism - 'retry'. Because ISO 15765-2 does not support such a mechanism, the CAN Transport
-     * Layer does not implement any kind of recovery. Thus, the parameter is always set to NULL
-     * pointer. */
-    result = PduR_CanTpCopyTxData(pNSdu->tx.cfg->nSduId, &tmp_pdu, NULL_PTR, &pNSdu->tx.buf.rmng);
+        /* SWS_CanTp_00272: the API PduR_CanTpCopyTxData() contains a parameter used for the
+         * recovery mechanism - 'retry'. Because ISO 15765-2 does not support such a mechanism, the
+         * CAN Transport Layer does not implement any kind of recovery. Thus, the parameter is always
+         * set to NULL pointer. */
+        result = PduR_CanTpCopyTxData(pNSdu->tx->cfg->nSduId, &tmp_pdu, NULL_PTR, &pNSdu->tx->buf.rmng);
+    }
 
     switch (result)
     {
         case BUFREQ_OK:
         {
             CanTp_StopNetworkLayerTimeout(p_n_sdu, CANTP_I_N_CS);
+            CanTp_EndTxStall(p_n_sdu);
 
             ofs += tmp_pdu.SduLength;
-            p_n_sdu->tx.buf.size -= tmp_pdu.SduLength;
+            p_n_sdu->tx->buf.size -= tmp_pdu.SduLength;
 
             *pOfs = ofs;
 
@@ -2683,8 +5863,20 @@ static BufReq_ReturnType CanTp_CopyTxPayload(CanTp_NSduType *pNSdu, PduLengthTyp
 
             break;
         }
-        case BUFREQ_E_OVFL:
         case BUFREQ_E_BUSY:
+        {
+            /* SWS_CanTp_00184: the request is retried until N_Cs expires, the stall counters
+             * record how often and how long the upper layer could not provide the data. */
+            if (p_n_sdu->tx->stall.active == FALSE)
+            {
+                p_n_sdu->tx->stall.active = TRUE;
+                p_n_sdu->tx->stall.since = CanTp_Now;
+                p_n_sdu->tx->stall.status.count++;
+            }
+
+            break;
+        }
+        case BUFREQ_E_OVFL:
         default:
         {
             break;
@@ -2698,8 +5890,31 @@ static void CanTp_SetPadding(uint8 *pBuffer, PduLengthType *pOfs, const uint8 va
 {
     uint8 *p_buffer = pBuffer;
     PduLengthType ofs = *pOfs;
+    PduLengthType size;
+
+    /* valid CAN FD data lengths are 8, 12, 16, 20, 24, 32, 48 and 64 bytes. */
+    if (ofs <= CANTP_CAN_FRAME_SIZE)
+    {
+        size = CANTP_CAN_FRAME_SIZE;
+    }
+    else if (ofs <= 0x18u)
+    {
+        size = (ofs + 0x03u) & ~(PduLengthType)0x03u;
+    }
+    else if (ofs <= 0x20u)
+    {
+        size = 0x20u;
+    }
+    else if (ofs <= 0x30u)
+    {
+        size = 0x30u;
+    }
+    else
+    {
+        size = CANTP_CAN_FD_FRAME_SIZE;
+    }
 
-    for (; ofs < CANTP_CAN_FRAME_SIZE; ofs++)
+    for (; ofs < size; ofs++)
     {
         p_buffer[ofs] = value;
     }
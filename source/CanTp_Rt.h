@@ -0,0 +1,476 @@
+/**
+ * @file CanTp_Rt.h
+ * @author
+ * @date
+ *
+ * @brief runtime data types of the CanTp module. this header is private: it is only included by
+ * CanTp.c and by the generated configuration source, which allocates the runtime storage.
+ */
+
+#ifndef CANTP_RT_H
+#define CANTP_RT_H
+
+#ifdef __cplusplus
+
+extern "C"
+{
+
+#endif /* ifdef __cplusplus */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* included files (#include).                                                                    */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_RT_H
+ * @{
+ */
+
+#ifndef CANTP_TYPES_H
+#include "CanTp_Types.h"
+#endif /* #ifndef CANTP_TYPES_H */
+
+/** @} */
+
+
+/*-----------------------------------------------------------------------------------------------*/
+/* runtime data type definitions (typedef, struct).                                              */
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ * @addtogroup CANTP_RT_H
+ * @{
+ */
+
+typedef uint8 CanTp_FlowStatusType;
+
+typedef enum {
+    CANTP_FRAME_STATE_INVALID = 0x00u,
+    CANTP_RX_FRAME_STATE_FC_TX_REQUEST,
+    CANTP_RX_FRAME_STATE_FC_TX_CONFIRMATION,
+    CANTP_RX_FRAME_STATE_FC_OVFLW_TX_CONFIRMATION,
+    CANTP_RX_FRAME_STATE_CF_RX_INDICATION,
+    CANTP_TX_FRAME_STATE_SF_TX_REQUEST,
+    CANTP_TX_FRAME_STATE_SF_TX_CONFIRMATION,
+    CANTP_TX_FRAME_STATE_FF_TX_REQUEST,
+    CANTP_TX_FRAME_STATE_FF_TX_CONFIRMATION,
+    CANTP_TX_FRAME_STATE_CF_TX_REQUEST,
+    CANTP_TX_FRAME_STATE_CF_TX_CONFIRMATION,
+    CANTP_TX_FRAME_STATE_FC_RX_INDICATION,
+    CANTP_FRAME_STATE_OK,
+    CANTP_FRAME_STATE_ABORT
+} CanTp_FrameStateType;
+
+typedef enum
+{
+    CANTP_WAIT = 0x00u,
+    CANTP_PROCESSING
+} CanTp_TaskStateType;
+
+typedef struct
+{
+    uint8 can[CANTP_CAN_FD_FRAME_SIZE];
+    PduLengthType size;
+    PduLengthType rmng;
+} CanTp_NSduBufferType;
+
+/**
+ * @brief frame geometry of a connection: the constants derived from the addressing format and the
+ * data link layer data length of an N-SDU, computed once by @ref CanTp_Init instead of on each
+ * frame.
+ */
+typedef struct
+{
+    /**
+     * @brief largest payload of a SF (the SF_DL escape sequence is used if the DL is > 8).
+     */
+    PduLengthType sf_max_dl;
+
+    /**
+     * @brief payload of a FF whose FF_DL is encoded on 12 bits.
+     */
+    PduLengthType ff_dl;
+
+    /**
+     * @brief payload of a CF which is not the last one of the N-SDU. for a Rx N-SDU, it is updated
+     * with the RX_DL of each received FF.
+     */
+    PduLengthType cf_dl;
+
+    /**
+     * @brief size of the N_AI field (N_TA or N_AE) preceding the N_PCI field: 0 or 1 byte.
+     */
+    uint8 n_ai_size;
+
+    /**
+     * @brief header template: N_TA or N_AE value copied in the first byte of each transmitted
+     * N-PDU (overwritten by the N_PCI field if n_ai_size is 0).
+     */
+    uint8 n_ai;
+
+    /**
+     * @brief the addressing format is supported, received N-PDUs can be decoded.
+     */
+    boolean af_valid;
+
+    /**
+     * @brief the N_TA/N_AE value required by the addressing format is configured, N-PDUs can be
+     * transmitted.
+     */
+    boolean n_ai_valid;
+} CanTp_FrameGeometryType;
+
+struct CanTp_RxConnection
+{
+    const CanTp_RxNSduType *cfg;
+    CanTp_FrameGeometryType geometry;
+    CanTp_NSduBufferType buf;
+    CanTp_FlowStatusType fs;
+    uint8 bs;
+    uint8 sn;
+    uint16 wft_max;
+
+    /**
+     * @brief received data link layer data length (RX_DL) of the ongoing segmented reception,
+     * derived from the length of the FF.
+     */
+    uint8 dl;
+
+    /**
+     * @brief destination buffer registered through @ref CanTp_SetRxBuffer for the ongoing
+     * reception: p_data points to the next byte to write and size is the remaining capacity.
+     */
+    struct
+    {
+        uint8 *p_data;
+        PduLengthType size;
+    } dst;
+
+    /**
+     * @brief staging buffer of the received payload: p_data points to the cfg->rxStagingSize bytes
+     * owned by this connection, the first cnt bytes not being handed over to the upper layer yet.
+     */
+    struct
+    {
+        uint8 *p_data;
+        uint16 cnt;
+    } staging;
+    PduInfoType can_if_pdu_info;
+
+    /**
+     * @brief the FC described by can_if_pdu_info has been rejected by CanIf and has to be
+     * transmitted again.
+     */
+    boolean retry;
+    PduInfoType pdu_r_pdu_info;
+};
+
+/**
+ * @brief transmit request waiting in the queue of a Tx N-SDU for the end of the ongoing session.
+ */
+typedef struct
+{
+    const uint8 *p_data;
+    PduLengthType length;
+    CanTp_FrameStateType state;
+} CanTp_TxRequestType;
+
+struct CanTp_TxConnection
+{
+    const CanTp_TxNSduType *cfg;
+    CanTp_FrameGeometryType geometry;
+    CanTp_NSduBufferType buf;
+    CanTp_FlowStatusType fs;
+    uint32 target_st_min;
+    uint16 bs;
+    uint8 sn;
+    uint8 burst_cnt;
+
+    /**
+     * @brief CFs handed over to CanIf and not yet confirmed: in_flight_cnt CFs, the oldest one
+     * being at in_flight_idx in the ring of their transmission times, used to observe N_As for
+     * each of them. p_sent_at points to the cfg->txWindow entries of the ring owned by this
+     * connection, NULL_PTR if a single CF is in flight at a time (txWindow of 0 or 1).
+     */
+    uint8 in_flight_cnt;
+    uint8 in_flight_idx;
+    uint32 *p_sent_at;
+
+    /**
+     * @brief payload provided through @ref CanTp_TransmitBuffer, advanced each time a frame is
+     * built from it. NULL_PTR if the payload is requested through PduR_CanTpCopyTxData.
+     */
+    const uint8 *p_data;
+    PduInfoType can_if_pdu_info;
+
+    /**
+     * @brief the N-PDU described by can_if_pdu_info has been rejected by CanIf and has to be
+     * transmitted again.
+     */
+    boolean retry;
+
+    /**
+     * @brief queue of the transmit requests waiting for the end of the ongoing session: p_request
+     * points to the cfg->txQueueDepth entries owned by this connection, the oldest request being at
+     * index head.
+     */
+    struct
+    {
+        CanTp_TxRequestType *p_request;
+        uint8 head;
+        CanTp_TxQueueStatusType status;
+    } queue;
+
+    /**
+     * @brief while active is TRUE, the upper layer could not provide the payload of the next frame
+     * (BUFREQ_E_BUSY) since the time stored in since. resume is set by @ref CanTp_TxDataAvailable,
+     * the payload is then requested again by the next main function call.
+     */
+    struct
+    {
+        uint32 since;
+        boolean active;
+        boolean resume;
+        CanTp_TxStallStatusType status;
+    } stall;
+
+    /**
+     * @brief staging buffer of the payload requested from the upper layer: p_data points to the
+     * cfg->txStagingSize bytes owned by this connection, cnt bytes not yet transmitted being at
+     * index ofs.
+     */
+    struct
+    {
+        uint8 *p_data;
+        uint16 ofs;
+        uint16 cnt;
+    } staging;
+};
+
+/**
+ * @brief task and frame states of one direction of an N-SDU.
+ */
+typedef struct
+{
+    CanTp_TaskStateType taskState;
+    CanTp_FrameStateType state;
+} CanTp_ConnectionStateType;
+
+typedef struct CanTp_NSdu
+{
+    /*
+     * hot data: the list links, task/frame states and timer masks read by CanTp_MainFunction for
+     * each active N-SDU are grouped at the beginning of the structure. the connection record of a
+     * direction is only dereferenced if that direction is processing (e.g. burst counter, N_Br
+     * polling), never for an idle direction.
+     */
+
+    /**
+     * @brief links of the intrusive list of N-SDUs having at least one ongoing session (see @ref
+     * CanTp_ActiveNSdu).
+     */
+    struct
+    {
+        struct CanTp_NSdu *prev;
+        struct CanTp_NSdu *next;
+        boolean linked;
+    } active;
+
+    /**
+     * @brief states of the reception and transmission connections.
+     */
+    CanTp_ConnectionStateType rx_shared;
+    CanTp_ConnectionStateType tx_shared;
+
+    /**
+     * @brief state of the N_As, N_Bs, N_Cs, N_Ar, N_Br, N_Cr and STmin timers of this N-SDU. timers
+     * are not incremented by @ref CanTp_MainFunction, each running timer owns an entry of @ref
+     * CanTp_TimerHeap holding its absolute deadline.
+     */
+    struct
+    {
+        uint32 active;
+        uint32 expired;
+    } timer;
+
+    /*
+     * cold data: only accessed when a frame is received, transmitted or confirmed, or when a timer
+     * is started or stopped.
+     */
+
+    uint8_least dir;
+
+    /**
+     * @brief reception and transmission connections of the N-SDU. a direction which is not
+     * configured, or which is not bound to a connection of the connection pools, points to an idle
+     * placeholder connection owned by the CanTp module, so that both pointers are always valid.
+     */
+    CanTp_RxConnectionType *rx;
+    CanTp_TxConnectionType *tx;
+    const CanTp_ChannelType *channel;
+
+    /**
+     * @brief configuration of the reception and transmission directions, NULL_PTR if the direction
+     * is not configured. they remain valid while no connection is bound to the direction.
+     */
+    const CanTp_RxNSduType *rx_cfg;
+    const CanTp_TxNSduType *tx_cfg;
+
+    /**
+     * @brief structure containing all parameters accessible via @ref CanTp_ReadParameter/@ref
+     * CanTp_ChangeParameter.
+     */
+    struct
+    {
+        uint32 st_min;
+        uint8 bs;
+    } m_param;
+
+    /**
+     * @brief position in @ref CanTp_TimerHeap of each running timer of this N-SDU.
+     */
+    uint32 timer_idx[CANTP_NUM_OF_TIMER_PER_N_SDU];
+
+    /**
+     * @brief the N-SDU is dynamically addressed: it only serves as template of the connection pool
+     * entries on which its sessions run, and never has an ongoing session itself.
+     */
+    boolean dynamic;
+
+    /**
+     * @brief connection pool entry owning this N-SDU, NULL_PTR for the N-SDUs of the configuration.
+     */
+    CanTp_PeerType *p_peer;
+
+    /**
+     * @brief for a dynamically addressed N-SDU, the connection pool entry whose N-PDUs have been
+     * handed over to CanIf and are not confirmed yet, NULL_PTR if none. the peers use different CAN
+     * identifiers, which CanIf may confirm in any order: as CanTp_TxConfirmation only carries the
+     * identifier of the N-SDU, only one entry at a time may have unconfirmed N-PDUs. the N-PDU of
+     * another entry is deferred until then (see @ref CanTp_Peer::deferred), so the sessions with
+     * several peers of the same N-SDU are serialized frame by frame and each of them may lose up to
+     * one confirmation latency of its N_As/N_Ar budget per frame.
+     */
+    CanTp_PeerType *p_unconfirmed;
+} CanTp_NSduType;
+
+/**
+ * @brief entry of the connection pool of the dynamically addressed N-SDUs: while bound to one of
+ * them, it holds the sessions exchanged with one peer, identified by its (N_SA, N_TA) pair.
+ */
+struct CanTp_Peer
+{
+    /**
+     * @brief runtime slot on which the sessions with the peer run, its rx and tx members pointing to
+     * the connections below.
+     */
+    CanTp_NSduType n_sdu;
+    CanTp_RxConnectionType rx;
+    CanTp_TxConnectionType tx;
+
+    /**
+     * @brief dynamically addressed N-SDU the entry is bound to, NULL_PTR if the entry is free.
+     */
+    CanTp_NSduType *p_template;
+
+    /**
+     * @brief address of this node and address of the peer.
+     */
+    uint8 local;
+    uint8 remote;
+
+    /**
+     * @brief CAN_ID_32 meta data of the N-PDUs received from the peer and of the N-PDUs transmitted
+     * to it, handed over to the upper layer and to CanIf respectively.
+     */
+    uint8 rx_meta[CANTP_META_DATA_SIZE];
+    uint8 tx_meta[CANTP_META_DATA_SIZE];
+
+    /**
+     * @brief number of N-PDUs handed over to CanIf and not yet confirmed.
+     */
+    uint8 pending;
+
+    /**
+     * @brief the last N-PDU could not be handed over to CanIf because another entry bound to the
+     * same N-SDU has unconfirmed N-PDUs, it is transmitted again like a N-PDU rejected by CanIf.
+     */
+    boolean deferred;
+};
+
+/**
+ * @brief entry of the timer heap: absolute deadline of a running timer of an N-SDU.
+ */
+struct CanTp_Timer
+{
+    uint32 deadline;
+    CanTp_NSduType *p_n_sdu;
+    uint8 instance_id;
+};
+
+/**
+ * @brief runtime storage of a channel, allocated by the generated configuration.
+ */
+struct CanTp_ChannelRt
+{
+    /**
+     * @brief N-SDU slots of the channel, indexed by the slot given in the PduId map.
+     */
+    CanTp_NSduType *pNSdu;
+
+    /**
+     * @brief number of entries of the array pointed by pNSdu.
+     */
+    const uint32 nSduCnt;
+
+    /**
+     * @brief reception connections, one per Rx N-SDU of the channel (same order as nSdu.rx).
+     * NULL_PTR if the reception connections are allocated from the connection pool.
+     */
+    CanTp_RxConnectionType *pRxConnection;
+
+    /**
+     * @brief transmission connections, one per Tx N-SDU of the channel (same order as nSdu.tx).
+     * NULL_PTR if the transmission connections are allocated from the connection pool.
+     */
+    CanTp_TxConnectionType *pTxConnection;
+
+    /**
+     * @brief storage of the transmit request queues, each Tx N-SDU of the channel owning
+     * txQueueDepth consecutive entries (same order as nSdu.tx). NULL_PTR if no queue is configured.
+     */
+    CanTp_TxRequestType *pTxRequest;
+
+    /**
+     * @brief storage of the transmit staging buffers, each Tx N-SDU of the channel owning
+     * txStagingSize consecutive bytes (same order as nSdu.tx). NULL_PTR if no staging buffer is
+     * configured.
+     */
+    uint8 *pTxStaging;
+
+    /**
+     * @brief storage of the rings of transmission times of the CFs in flight, each Tx N-SDU of the
+     * channel having a txWindow greater than 1 owning txWindow consecutive entries (same order as
+     * nSdu.tx). NULL_PTR if no such N-SDU is configured.
+     */
+    uint32 *pTxSentAt;
+
+    /**
+     * @brief storage of the receive staging buffers, each Rx N-SDU of the channel owning
+     * rxStagingSize consecutive bytes (same order as nSdu.rx). NULL_PTR if no staging buffer is
+     * configured.
+     */
+    uint8 *pRxStaging;
+};
+
+/** @} */
+
+
+#ifdef __cplusplus
+
+};
+
+#endif /* ifdef __cplusplus */
+
+#endif /* define CANTP_RT_H */
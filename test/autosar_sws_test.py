@@ -451,6 +451,25 @@ def test_sws_00224(bs, data_size):
     assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] & 0x0F == 0
 
 
+@pytest.mark.parametrize('bs', (1, 4, 15))
+def test_sws_00224_next_block(bs):
+    """
+    The FC(CTS) is also sent after the last Consecutive Frame of each block, and the Consecutive Frames of the next block
+    are then received.
+    """
+    handle = CanTpTest(DefaultReceiver(bs=bs), rx_buffer_size=100)
+    payload = [i & 0xFF for i in range(100)]
+    handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, len(payload)] + payload[:6]))
+    for sn, ofs in enumerate(range(6, len(payload), 7), start=1):
+        if (sn - 1) % bs == 0:
+            handle.lib.CanTp_MainFunction()
+            assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] & 0x0F == 0
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x20 | (sn & 0x0F)] + payload[ofs:ofs + 7]))
+    handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+    assert handle.can_tp_rx_data == payload
+
+
 class TestSWS00229:
     """
     If the task was aborted due to As, Bs, Cs, Ar, Br, Cr timeout, the CanTp module shall raise the DET error
@@ -0,0 +1,1307 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+from math import ceil
+
+try:
+    from unittest.mock import ANY
+except ImportError:
+    from mock import ANY
+
+from .parameter import *
+from .ffi import CanTpTest
+
+
+class TestTicklessScheduling:
+    """
+    CanTp_GetNextDeadline returns the time remaining until the main function has to be called next (0 if some work is
+    pending right away), or E_NOT_OK if nothing is pending. CanTp_MainFunctionElapsed advances the time base by the
+    given elapsed time before processing the N-SDUs.
+    """
+
+    @staticmethod
+    def get_next_deadline(handle):
+        deadline = handle.ffi.new('uint32 *')
+        result = handle.lib.CanTp_GetNextDeadline(deadline)
+        return result, deadline[0]
+
+    def test_nothing_pending_after_init(self):
+        handle = CanTpTest(DefaultSender())
+        assert self.get_next_deadline(handle)[0] == handle.define('E_NOT_OK')
+
+    def test_pending_transmit_request(self):
+        handle = CanTpTest(DefaultSender())
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        assert self.get_next_deadline(handle) == (handle.define('E_OK'), 0)
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        handle.can_if_transmit.assert_called_once()
+
+    @pytest.mark.parametrize('n_as', n_as_timeouts)
+    def test_n_as_deadline(self, n_as):
+        handle = CanTpTest(DefaultSender(n_as=n_as))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        result, deadline = self.get_next_deadline(handle)
+        assert result == handle.define('E_OK')
+        assert 0 < deadline <= round(n_as * 1000000)
+        handle.lib.CanTp_MainFunctionElapsed(deadline - 1)
+        handle.pdu_r_can_tp_tx_confirmation.assert_not_called()
+        assert self.get_next_deadline(handle) == (handle.define('E_OK'), 1)
+        handle.lib.CanTp_MainFunctionElapsed(1)
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_NOT_OK'))
+
+    def test_st_min_deadline(self):
+        handle = CanTpTest(DefaultSender())
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 20))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0, st_min=0xF5)))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 2
+        assert self.get_next_deadline(handle) == (handle.define('E_OK'), 500)
+        handle.lib.CanTp_MainFunctionElapsed(500)
+        assert handle.can_if_transmit.call_count == 3
+
+    def test_nothing_pending_after_completion(self):
+        handle = CanTpTest(DefaultSender())
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        assert self.get_next_deadline(handle)[0] == handle.define('E_NOT_OK')
+
+    def test_n_br_polling_period(self):
+        handle = CanTpTest(DefaultReceiver(main_period=0.001), rx_buffer_size=10)
+        ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 100)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        handle.lib.CanTp_MainFunctionElapsed(0)
+        copy_cnt = handle.pdu_r_can_tp_copy_rx_data.call_count
+        assert self.get_next_deadline(handle) == (handle.define('E_OK'), 1000)
+        handle.lib.CanTp_MainFunctionElapsed(1000)
+        assert handle.pdu_r_can_tp_copy_rx_data.call_count == copy_cnt + 1
+
+
+class TestImmediateProcessing:
+    """
+    If the processing mode of a channel is CANTP_IMMEDIATE_PROCESSING, the FC following the reception of a FF or of the
+    last CF of a block is transmitted from CanTp_RxIndication instead of the next call of CanTp_MainFunction.
+    """
+
+    @pytest.mark.parametrize('af', addressing_formats)
+    def test_flow_control_sent_on_first_frame(self, af):
+        handle = CanTpTest(DefaultReceiver(af=af, bs=1, processing_mode='CANTP_IMMEDIATE_PROCESSING'))
+        ff, cfs = handle.get_receiver_multi_frame((dummy_byte,) * 20, af=af, bs=1)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        handle.can_if_transmit.assert_called_once()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(cfs[0]))
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_flow_control_deferred_by_default(self):
+        handle = CanTpTest(DefaultReceiver())
+        ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 20)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        handle.can_if_transmit.assert_not_called()
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.assert_called_once()
+
+    def test_flow_control_wait_not_sent_immediately(self):
+        handle = CanTpTest(DefaultReceiver(processing_mode='CANTP_IMMEDIATE_PROCESSING'), rx_buffer_size=10)
+        ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 100)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        handle.can_if_transmit.assert_not_called()
+
+
+class TestConsecutiveFrameBurst:
+    """
+    If a burst size is configured for a Tx N-SDU, the next CF is transmitted from CanTp_TxConfirmation as soon as STmin
+    has elapsed, until the number of CFs sent during the current main function period reaches the burst size.
+    """
+
+    @staticmethod
+    def start_transmission(handle, st_min=0):
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 100))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0, st_min=st_min)))
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+
+    @pytest.mark.parametrize('burst_size', (2, 4, 8))
+    def test_burst_limited_per_period(self, burst_size):
+        handle = CanTpTest(DefaultSender(burst_size=burst_size))
+        self.start_transmission(handle)
+        for _ in range(burst_size):
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 1 + burst_size
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2 + burst_size
+
+    def test_no_burst_by_default(self):
+        handle = CanTpTest(DefaultSender())
+        self.start_transmission(handle)
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_no_burst_while_st_min_running(self):
+        handle = CanTpTest(DefaultSender(burst_size=8))
+        self.start_transmission(handle, st_min=1)
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 2
+
+
+class TestTransmitWindow:
+    """
+    If a transmit window K > 1 is configured for a Tx N-SDU and the receiver requested a STmin of 0, up to K CFs are
+    handed over to CanIf without waiting for the confirmation of the previous ones. N_As is observed for each of them
+    from its own transmission time.
+    """
+
+    @staticmethod
+    def start_transmission(handle, size=100, bs=0, st_min=0):
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * size))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=bs, st_min=st_min)))
+        handle.lib.CanTp_MainFunction()
+
+    @pytest.mark.parametrize('transmit_window', (2, 4, 8))
+    def test_window_filled(self, transmit_window):
+        handle = CanTpTest(DefaultSender(n_as=0.1, window=transmit_window))
+        self.start_transmission(handle)
+        assert handle.can_if_transmit.call_count == 1 + transmit_window
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 2 + transmit_window
+
+    def test_whole_transmission(self):
+        handle = CanTpTest(DefaultSender(n_as=0.1, window=4))
+        self.start_transmission(handle)
+        for _ in range(ceil((100 - 6) / 7)):
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 1 + ceil((100 - 6) / 7)
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+
+    def test_window_limited_by_block_size(self):
+        handle = CanTpTest(DefaultSender(n_as=0.1, window=8))
+        self.start_transmission(handle, bs=3)
+        assert handle.can_if_transmit.call_count == 1 + 3
+        for _ in range(3):
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 1 + 3
+        handle.pdu_r_can_tp_tx_confirmation.assert_not_called()
+
+    def test_single_frame_in_flight_with_st_min(self):
+        handle = CanTpTest(DefaultSender(n_as=0.1, window=8))
+        self.start_transmission(handle, st_min=1)
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_single_frame_in_flight_by_default(self):
+        handle = CanTpTest(DefaultSender())
+        self.start_transmission(handle)
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_n_as_per_frame(self):
+        handle = CanTpTest(DefaultSender(n_as=10 * DefaultSender().main_period, window=2))
+        self.start_transmission(handle)
+        for _ in range(4):
+            handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        # the second CF has been handed over to CanIf together with the first one, 5 of its 10 periods are elapsed: N_As
+        # expires at the end of the 5th call and the transmission is aborted by the 6th one.
+        for _ in range(5):
+            handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_not_called()
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_NOT_OK'))
+
+
+class TestTransmitQueue:
+    """
+    If a transmit queue depth is configured for a Tx N-SDU, CanTp_Transmit accepts up to that number of requests while a
+    session is ongoing, and starts them in order as soon as the previous session ends. CanTp_GetTxQueueStatus returns the
+    counters of the queue.
+    """
+
+    @staticmethod
+    def get_status(handle):
+        status = handle.ffi.new('CanTp_TxQueueStatusType *')
+        assert handle.lib.CanTp_GetTxQueueStatus(0, status) == handle.define('E_OK')
+        return status.enqueued, status.dequeued, status.rejected, status.pending
+
+    @staticmethod
+    def transmit(handle, size=4):
+        return handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * size))
+
+    def test_requests_queued_while_busy(self):
+        handle = CanTpTest(DefaultSender(queue_depth=2))
+        assert self.transmit(handle) == handle.define('E_OK')
+        assert self.transmit(handle) == handle.define('E_OK')
+        assert self.transmit(handle) == handle.define('E_OK')
+        assert self.transmit(handle) == handle.define('E_NOT_OK')
+        assert self.get_status(handle) == (2, 0, 1, 2)
+
+    def test_next_request_started_in_same_period(self):
+        handle = CanTpTest(DefaultSender(queue_depth=1))
+        self.transmit(handle, size=4)
+        self.transmit(handle, size=5)
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.can_if_transmit.call_count == 2
+        assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] == 5
+        assert self.get_status(handle) == (1, 1, 0, 0)
+
+    def test_next_request_started_after_abort(self):
+        handle = CanTpTest(DefaultSender(queue_depth=1))
+        self.transmit(handle)
+        self.transmit(handle)
+        handle.lib.CanTp_MainFunction()
+        assert handle.lib.CanTp_CancelTransmit(0) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_segmented_requests(self):
+        handle = CanTpTest(DefaultSender(queue_depth=1))
+        self.transmit(handle, size=20)
+        self.transmit(handle, size=20)
+        for _ in range(2):
+            handle.lib.CanTp_MainFunction()
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+            handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0)))
+            for _ in range(ceil((20 - 6) / 7)):
+                handle.lib.CanTp_MainFunction()
+                handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_tx_confirmation.call_count == 2
+        assert all(c[0] == (0, handle.define('E_OK')) for c in handle.pdu_r_can_tp_tx_confirmation.call_args_list)
+
+    def test_requests_rejected_by_default(self):
+        handle = CanTpTest(DefaultSender())
+        assert self.transmit(handle) == handle.define('E_OK')
+        assert self.transmit(handle) == handle.define('E_NOT_OK')
+        assert self.get_status(handle) == (0, 0, 0, 0)
+
+
+class TestTransmitRetry:
+    """
+    If transmit retry is enabled for an N-SDU, an N-PDU rejected by CanIf_Transmit is transmitted again on the next calls
+    of CanTp_MainFunction, or right away when CanTp_TxMailboxFree is called, until N_As (resp. N_Ar) expires.
+    """
+
+    def test_single_frame_retried(self):
+        handle = CanTpTest(DefaultSender(retry=True))
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+        handle.can_if_transmit.return_value = handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 3
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 3
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+
+    def test_consecutive_frame_retried(self):
+        handle = CanTpTest(DefaultSender(retry=True))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 20))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0)))
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.return_value = handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 3
+        assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] >> 4 == 2
+        for _ in range(2):
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+            handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+
+    def test_retried_on_mailbox_free(self):
+        handle = CanTpTest(DefaultSender(retry=True))
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.return_value = handle.define('E_OK')
+        handle.lib.CanTp_TxMailboxFree()
+        assert handle.can_if_transmit.call_count == 2
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+
+    def test_aborted_on_n_as_timeout(self):
+        config = DefaultSender(n_as=10 * DefaultSender().main_period, retry=True)
+        handle = CanTpTest(config)
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        for _ in range(20):
+            handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_NOT_OK'))
+        assert handle.can_if_transmit.call_count <= 11
+
+    def test_flow_control_retried(self):
+        handle = CanTpTest(DefaultReceiver(retry=True))
+        ff, cfs = handle.get_receiver_multi_frame((dummy_byte,) * 20)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.return_value = handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        for cf in cfs:
+            handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(cf))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+
+    def test_no_retry_by_default(self):
+        handle = CanTpTest(DefaultSender())
+        handle.can_if_transmit.return_value = handle.define('E_NOT_OK')
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.assert_called_once()
+
+
+class TestRxBufferAvailable:
+    """
+    If buffer notification is enabled for a Rx N-SDU, PduR_CanTpCopyRxData is not polled while N_Br is running: the upper
+    layer calls CanTp_RxBufferAvailable once buffer space is released, and the FC(CTS) is transmitted right away if the
+    available buffer is large enough for the next block.
+    """
+
+    @staticmethod
+    def start_reception(handle, size=100):
+        ff, cfs = handle.get_receiver_multi_frame((dummy_byte,) * size)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(ff))
+        return cfs
+
+    def test_no_polling_while_waiting(self):
+        handle = CanTpTest(DefaultReceiver(buffer_notification=True), rx_buffer_size=10)
+        self.start_reception(handle)
+        copy_cnt = handle.pdu_r_can_tp_copy_rx_data.call_count
+        for _ in range(10):
+            handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_copy_rx_data.call_count == copy_cnt
+        handle.can_if_transmit.assert_not_called()
+
+    def test_flow_control_sent_on_notification(self):
+        handle = CanTpTest(DefaultReceiver(buffer_notification=True), rx_buffer_size=10)
+        cfs = self.start_reception(handle)
+        handle.lib.CanTp_MainFunction()
+        handle.available_rx_buffer = 0x0FFF
+        assert handle.lib.CanTp_RxBufferAvailable(0, 0x0FFF) == handle.define('E_OK')
+        handle.can_if_transmit.assert_called_once()
+        assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] == 0x30
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        for cf in cfs[:2]:
+            handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(cf))
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+        handle.pdu_r_can_tp_rx_indication.assert_not_called()
+
+    def test_buffer_still_too_small(self):
+        handle = CanTpTest(DefaultReceiver(buffer_notification=True), rx_buffer_size=10)
+        self.start_reception(handle)
+        assert handle.lib.CanTp_RxBufferAvailable(0, 12) == handle.define('E_OK')
+        handle.can_if_transmit.assert_not_called()
+
+    def test_no_reception_waiting(self):
+        handle = CanTpTest(DefaultReceiver(buffer_notification=True))
+        assert handle.lib.CanTp_RxBufferAvailable(0, 0x0FFF) == handle.define('E_NOT_OK')
+        self.start_reception(handle)
+        assert handle.lib.CanTp_RxBufferAvailable(0, 0x0FFF) == handle.define('E_NOT_OK')
+
+    def test_polling_by_default(self):
+        handle = CanTpTest(DefaultReceiver(), rx_buffer_size=10)
+        self.start_reception(handle)
+        copy_cnt = handle.pdu_r_can_tp_copy_rx_data.call_count
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_copy_rx_data.call_count == copy_cnt + 1
+
+
+class TestTxDataAvailable:
+    """
+    If data notification is enabled for a Tx N-SDU, PduR_CanTpCopyTxData is not polled after it returned BUFREQ_E_BUSY:
+    the upper layer calls CanTp_TxDataAvailable, and the pending frame is transmitted by the next main function call.
+    CanTp_GetTxStallStatus returns how often and how long the upper layer could not provide the data.
+    """
+
+    @staticmethod
+    def get_status(handle):
+        status = handle.ffi.new('CanTp_TxStallStatusType *')
+        assert handle.lib.CanTp_GetTxStallStatus(0, status) == handle.define('E_OK')
+        return status.count, status.total_time, status.max_time
+
+    @staticmethod
+    def start_stall(handle, size=4):
+        handle.pdu_r_can_tp_copy_tx_data.return_value = handle.lib.BUFREQ_E_BUSY
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * size))
+        handle.lib.CanTp_MainFunction()
+
+    def test_no_polling_while_stalled(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        self.start_stall(handle)
+        copy_cnt = handle.pdu_r_can_tp_copy_tx_data.call_count
+        for _ in range(10):
+            handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == copy_cnt
+        handle.can_if_transmit.assert_not_called()
+
+    def test_frame_sent_on_notification(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        self.start_stall(handle)
+        handle.pdu_r_can_tp_copy_tx_data.return_value = handle.lib.BUFREQ_OK
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_OK')
+        handle.can_if_transmit.assert_not_called()
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.assert_called_once()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+
+    def test_consecutive_frame_sent_on_notification(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 20))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.pdu_r_can_tp_copy_tx_data.return_value = handle.lib.BUFREQ_E_BUSY
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0, st_min=0)))
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 1
+        handle.pdu_r_can_tp_copy_tx_data.return_value = handle.lib.BUFREQ_OK
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 2
+        assert handle.can_if_transmit.call_args[0][1].SduDataPtr[0] >> 4 == 2
+
+    def test_still_busy_on_notification(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        self.start_stall(handle)
+        copy_cnt = handle.pdu_r_can_tp_copy_tx_data.call_count
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == copy_cnt + 1
+        handle.can_if_transmit.assert_not_called()
+        assert self.get_status(handle)[0] == 1
+
+    def test_main_function_due_on_notification(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        self.start_stall(handle)
+        deadline = handle.ffi.new('uint32 *')
+        assert handle.lib.CanTp_GetNextDeadline(deadline) == handle.define('E_OK')
+        assert deadline[0] > 0
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_OK')
+        assert handle.lib.CanTp_GetNextDeadline(deadline) == handle.define('E_OK')
+        assert deadline[0] == 0
+
+    def test_no_transmission_stalled(self):
+        handle = CanTpTest(DefaultSender(data_notification=True))
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_NOT_OK')
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        assert handle.lib.CanTp_TxDataAvailable(0) == handle.define('E_NOT_OK')
+
+    def test_polling_by_default(self):
+        handle = CanTpTest(DefaultSender(data_notification=False))
+        self.start_stall(handle)
+        copy_cnt = handle.pdu_r_can_tp_copy_tx_data.call_count
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == copy_cnt + 1
+
+    def test_stall_counters(self):
+        handle = CanTpTest(DefaultSender(data_notification=False))
+        assert self.get_status(handle) == (0, 0, 0)
+        self.start_stall(handle)
+        for _ in range(3):
+            handle.lib.CanTp_MainFunction()
+        assert self.get_status(handle) == (1, 0, 0)
+        handle.pdu_r_can_tp_copy_tx_data.return_value = handle.lib.BUFREQ_OK
+        handle.lib.CanTp_MainFunction()
+        assert self.get_status(handle) == (1, 4, 4)
+
+    def test_stall_ended_by_timeout(self):
+        config = DefaultSender(data_notification=True)
+        handle = CanTpTest(config)
+        self.start_stall(handle)
+        for _ in range(int(0.9 / config.main_period) + 1):
+            handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_NOT_OK'))
+        count, total_time, max_time = self.get_status(handle)
+        assert count == 1
+        assert total_time == max_time > 0
+
+
+class TestTransmitStaging:
+    """
+    If a transmit staging size is configured for a Tx N-SDU, the payload is requested from the upper layer in chunks of
+    up to that size (bounded by the data reported as available), and the frames are built from the staging buffer
+    instead of calling PduR_CanTpCopyTxData for each of them.
+    """
+
+    @staticmethod
+    def transmit(handle, payload, bs=0, available=None):
+        copied = [0]
+        frames = []
+
+        def copy_tx_data(_pdu_id, pdu_info, _retry, available_data):
+            for idx in range(pdu_info.SduLength):
+                pdu_info.SduDataPtr[idx] = payload[copied[0] + idx]
+            copied[0] += pdu_info.SduLength
+            available_data[0] = len(payload) - copied[0] if available is None else available
+            return handle.lib.BUFREQ_OK
+
+        def can_if_transmit(_pdu_id, pdu_info):
+            frames.append(list(pdu_info.SduDataPtr[0:pdu_info.SduLength]))
+            return handle.define('E_OK')
+
+        handle.pdu_r_can_tp_copy_tx_data.side_effect = copy_tx_data
+        handle.can_if_transmit.side_effect = can_if_transmit
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * len(payload)))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        for _ in range(ceil((len(payload) - 6) / 7)):
+            if bs == 0 and len(frames) == 1 or bs != 0 and (len(frames) - 1) % bs == 0:
+                fc = handle.get_receiver_flow_control(bs=bs, st_min=0)
+                handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(fc))
+            handle.lib.CanTp_MainFunction()
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        data = frames[0][2:]
+        for frame in frames[1:]:
+            data += frame[1:]
+        return data[:len(payload)]
+
+    @pytest.mark.parametrize('bs', (0, 2, 4))
+    def test_payload_transmitted(self, bs):
+        handle = CanTpTest(DefaultSender(staging_size=64))
+        payload = [idx & 0xFF for idx in range(100)]
+        assert self.transmit(handle, payload, bs=bs) == payload
+
+    def test_payload_requested_in_chunks(self):
+        handle = CanTpTest(DefaultSender(staging_size=64))
+        self.transmit(handle, [idx & 0xFF for idx in range(100)])
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == 3
+
+    def test_request_bounded_by_available_data(self):
+        handle = CanTpTest(DefaultSender(staging_size=64))
+        payload = [idx & 0xFF for idx in range(100)]
+        assert self.transmit(handle, payload, available=14) == payload
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == 1 + ceil((100 - 6) / 14)
+
+    def test_one_request_per_frame_by_default(self):
+        handle = CanTpTest(DefaultSender())
+        self.transmit(handle, [idx & 0xFF for idx in range(100)])
+        assert handle.pdu_r_can_tp_copy_tx_data.call_count == 1 + ceil((100 - 6) / 7)
+
+
+class TestCanFd:
+    """
+    If a TX_DL (resp. RX_DL) larger than 8 is configured for a Tx (resp. Rx) N-SDU, CAN FD frames are used: the payload
+    of SFs larger than a CAN 2.0 frame is encoded with the SF_DL escape sequence, FF and CF use the whole data length
+    and SF or last CF which do not match a valid CAN FD data length are padded up to the next one.
+    """
+
+    @staticmethod
+    def get_transmitted_frame(handle):
+        pdu_info = handle.can_if_transmit.call_args[0][1]
+        return [pdu_info.SduDataPtr[i] for i in range(pdu_info.SduLength)]
+
+    @pytest.mark.parametrize('size, can_dl', ((7, 8), (8, 12), (10, 12), (20, 24), (30, 32), (62, 64)))
+    def test_single_frame_escape_sequence(self, size, can_dl):
+        handle = CanTpTest(DefaultSender(tx_dl=64))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * size))
+        handle.lib.CanTp_MainFunction()
+        frame = self.get_transmitted_frame(handle)
+        assert len(frame) == can_dl
+        if size <= 7:
+            assert frame[0] == size
+        else:
+            assert frame[:2] == [0x00, size]
+
+    def test_single_frame_limited_by_tx_dl(self):
+        handle = CanTpTest(DefaultSender(tx_dl=16))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 15))
+        handle.lib.CanTp_MainFunction()
+        assert self.get_transmitted_frame(handle)[0] >> 4 == 1
+
+    def test_segmented_transmission(self):
+        handle = CanTpTest(DefaultSender(tx_dl=64))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 100))
+        handle.lib.CanTp_MainFunction()
+        frame = self.get_transmitted_frame(handle)
+        assert len(frame) == 64
+        assert frame[:2] == [0x10, 100]
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0)))
+        handle.lib.CanTp_MainFunction()
+        frame = self.get_transmitted_frame(handle)
+        assert frame[0] >> 4 == 2
+        assert len(frame) == 48
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+
+    @pytest.mark.parametrize('size', (8, 20, 62))
+    def test_single_frame_reception(self, size):
+        handle = CanTpTest(DefaultReceiver(rx_dl=64))
+        frame = [0x00, size] + list(range(size))
+        frame += [0xCC] * (64 - len(frame))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(frame))
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.can_tp_rx_data == list(range(size))
+
+    @pytest.mark.parametrize('sf_dl, can_dl', ((200, 12), (11, 12), (63, 64), (7, 12), (0, 12)))
+    def test_invalid_single_frame_escape_sequence_ignored(self, sf_dl, can_dl):
+        handle = CanTpTest(DefaultReceiver(rx_dl=64))
+        frame = [0x00, sf_dl] + [dummy_byte] * (can_dl - 2)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(frame))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+        handle.pdu_r_can_tp_rx_indication.assert_not_called()
+
+    def test_single_frame_without_escape_sequence_ignored(self):
+        handle = CanTpTest(DefaultReceiver(rx_dl=64))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x05] + [dummy_byte] * 11))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+        handle.pdu_r_can_tp_rx_indication.assert_not_called()
+
+    def test_segmented_reception(self):
+        handle = CanTpTest(DefaultReceiver(rx_dl=64))
+        payload = [i & 0xFF for i in range(100)]
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, 100] + payload[:62]))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x21] + payload[62:] + [0xCC] * 9))
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.can_tp_rx_data == payload
+
+    @pytest.mark.parametrize('ff_dl, cf_dl', ((64, 20), (16, 64), (8, 5)))
+    def test_consecutive_frame_data_length_mismatch_aborts(self, ff_dl, cf_dl):
+        handle = CanTpTest(DefaultReceiver(rx_dl=64))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, 200] + [dummy_byte] * (ff_dl - 2)))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x21] + [dummy_byte] * (cf_dl - 1)))
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_NOT_OK'))
+
+    def test_frame_longer_than_rx_dl_ignored(self):
+        handle = CanTpTest(DefaultReceiver())
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x00, 10] + [dummy_byte] * 10))
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+
+
+class TestFirstFrameEscapeSequence:
+    """
+    N-SDUs larger than 4095 bytes are transmitted and received with the FF_DL escape sequence: the 12 bits FF_DL of the
+    FF is set to zero and followed by a 32 bits FF_DL.
+    """
+
+    @pytest.mark.parametrize('size', (4096, 70000))
+    def test_escape_sequence_transmitted(self, size):
+        handle = CanTpTest(DefaultSender())
+        assert handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * size)) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        pdu_info = handle.can_if_transmit.call_args[0][1]
+        assert [pdu_info.SduDataPtr[i] for i in range(6)] == [0x10, 0x00] + list(size.to_bytes(4, 'big'))
+        assert pdu_info.SduLength == 8
+
+    def test_no_escape_sequence_below_4096(self):
+        handle = CanTpTest(DefaultSender())
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4095))
+        handle.lib.CanTp_MainFunction()
+        pdu_info = handle.can_if_transmit.call_args[0][1]
+        assert [pdu_info.SduDataPtr[i] for i in range(2)] == [0x1F, 0xFF]
+
+    def test_escape_sequence_received(self):
+        size = 5000
+        payload = [i & 0xFF for i in range(size)]
+        handle = CanTpTest(DefaultReceiver(bs=0, rx_dl=64), rx_buffer_size=size)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, 0x00] + list(size.to_bytes(4, 'big')) + payload[:58]))
+        assert handle.pdu_r_can_tp_start_of_reception.call_args[0][2] == size
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        for sn, ofs in enumerate(range(58, size, 63), start=1):
+            cf = [0x20 | (sn & 0x0F)] + payload[ofs:ofs + 63]
+            handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(cf + [0xCC] * (64 - len(cf))))
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.can_tp_rx_data == payload
+
+    @pytest.mark.parametrize('size', (0, 1, 4095))
+    def test_escape_sequence_below_4096_ignored(self, size):
+        handle = CanTpTest(DefaultReceiver(bs=0))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, 0x00] + list(size.to_bytes(4, 'big')) + [0, 0]))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+        handle.can_if_transmit.assert_not_called()
+
+    @pytest.mark.parametrize('frame', ([0x10, 0x00], [0x10, 0x00, 0x00, 0x00, 0x10]), ids=('truncated', 'undersized'))
+    def test_first_frame_shorter_than_header_ignored(self, frame):
+        handle = CanTpTest(DefaultReceiver(bs=0))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(frame))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+        handle.can_if_transmit.assert_not_called()
+
+    @pytest.mark.parametrize('size', (3, 7))
+    def test_first_frame_below_minimum_ignored(self, size):
+        handle = CanTpTest(DefaultReceiver(bs=0))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, size, 1, 2, 3, 4, 5, 6]))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+        handle.can_if_transmit.assert_not_called()
+
+
+class TestZeroCopyTransmit:
+    """
+    CanTp_TransmitBuffer transmits a N-SDU whose payload is provided by the caller: the frames are built directly from
+    the given buffer, and PduR_CanTpCopyTxData is never called.
+    """
+
+    @staticmethod
+    def get_transmitted_frames(handle):
+        frames = list()
+
+        def can_if_transmit(_tx_pdu_id, pdu_info):
+            frames.append([pdu_info.SduDataPtr[i] for i in range(pdu_info.SduLength)])
+            return handle.define('E_OK')
+
+        handle.can_if_transmit.side_effect = can_if_transmit
+        return frames
+
+    def test_single_frame(self):
+        handle = CanTpTest(DefaultSender())
+        frames = self.get_transmitted_frames(handle)
+        payload = [1, 2, 3, 4]
+        assert handle.lib.CanTp_TransmitBuffer(0, handle.get_pdu_info(payload)) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert frames == [[0x04] + payload]
+        handle.pdu_r_can_tp_copy_tx_data.assert_not_called()
+
+    def test_segmented_transmission(self):
+        handle = CanTpTest(DefaultSender())
+        frames = self.get_transmitted_frames(handle)
+        payload = [i & 0xFF for i in range(100)]
+        data = handle.ffi.new('uint8 []', payload)
+        pdu_info = handle.get_pdu_info(payload)
+        pdu_info.SduDataPtr = data
+        handle.lib.CanTp_TransmitBuffer(0, pdu_info)
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_flow_control(bs=0)))
+        while handle.pdu_r_can_tp_tx_confirmation.call_count == 0:
+            handle.lib.CanTp_MainFunction()
+            handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        handle.pdu_r_can_tp_copy_tx_data.assert_not_called()
+        assert frames[0][:2] == [0x10, 100]
+        assert frames[0][2:] + sum((frame[1:] for frame in frames[1:]), []) == payload
+
+    def test_copy_tx_data_used_by_transmit(self):
+        handle = CanTpTest(DefaultSender())
+        handle.lib.CanTp_TransmitBuffer(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_copy_tx_data.assert_called_once()
+
+    def test_null_data_pointer(self):
+        handle = CanTpTest(DefaultSender())
+        pdu_info = handle.get_pdu_info((dummy_byte,) * 4)
+        pdu_info.SduDataPtr = handle.ffi.NULL
+        assert handle.lib.CanTp_TransmitBuffer(0, pdu_info) == handle.define('E_NOT_OK')
+        handle.det_report_error.assert_called_once_with(handle.define('CANTP_MODULE_ID'), 0,
+                                                        handle.define('CANTP_TRANSMIT_BUFFER_API_ID'),
+                                                        handle.define('CANTP_E_PARAM_POINTER'))
+
+
+class TestZeroCopyReceive:
+    """
+    If the upper layer registers a destination buffer with CanTp_SetRxBuffer (typically from PduR_CanTpStartOfReception),
+    the payload is written directly into it and PduR_CanTpCopyRxData is not called anymore: the upper layer reads the
+    N-SDU from its buffer once PduR_CanTpRxIndication is called.
+    """
+
+    @staticmethod
+    def register_buffer(handle, size, buffer_size=None):
+        buffer = handle.ffi.new('uint8 []', size)
+
+        def start_of_reception(_i_pdu_id, _pdu_info, _tp_sdu_length, p_buffer_size):
+            assert handle.lib.CanTp_SetRxBuffer(0, buffer, buffer_size or size) == handle.define('E_OK')
+            p_buffer_size[0] = size
+            return handle.lib.BUFREQ_OK
+
+        handle.pdu_r_can_tp_start_of_reception.side_effect = start_of_reception
+        return buffer
+
+    @staticmethod
+    def receive(handle, payload, bs):
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x10, len(payload)] + payload[:6]))
+        for sn, ofs in enumerate(range(6, len(payload), 7), start=1):
+            if (sn - 1) % bs == 0:
+                handle.lib.CanTp_MainFunction()
+                handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+            handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x20 | (sn & 0x0F)] + payload[ofs:ofs + 7]))
+
+    def test_single_frame(self):
+        handle = CanTpTest(DefaultReceiver())
+        buffer = self.register_buffer(handle, 4)
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x04, 1, 2, 3, 4]))
+        assert list(buffer) == [1, 2, 3, 4]
+        handle.pdu_r_can_tp_copy_rx_data.assert_not_called()
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+
+    @pytest.mark.parametrize('bs', (1, 4, 15))
+    def test_no_copy_rx_data(self, bs):
+        handle = CanTpTest(DefaultReceiver(bs=bs))
+        payload = [i & 0xFF for i in range(100)]
+        buffer = self.register_buffer(handle, len(payload))
+        self.receive(handle, payload, bs)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        handle.pdu_r_can_tp_copy_rx_data.assert_not_called()
+        assert list(buffer) == payload
+
+    def test_buffer_too_small(self):
+        handle = CanTpTest(DefaultReceiver(bs=4))
+        payload = [i & 0xFF for i in range(100)]
+        self.register_buffer(handle, len(payload), buffer_size=50)
+        self.receive(handle, payload, 4)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_NOT_OK'))
+
+    def test_copy_rx_data_per_frame_by_default(self):
+        handle = CanTpTest(DefaultReceiver(bs=4))
+        payload = [i & 0xFF for i in range(100)]
+        self.receive(handle, payload, 4)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.pdu_r_can_tp_copy_rx_data.call_count >= 15
+        assert handle.can_tp_rx_data == payload
+
+    def test_no_reception_ongoing(self):
+        handle = CanTpTest(DefaultReceiver())
+        buffer = handle.ffi.new('uint8 []', 8)
+        assert handle.lib.CanTp_SetRxBuffer(0, buffer, 8) == handle.define('E_NOT_OK')
+
+
+class TestReceiveStaging:
+    """
+    If a receive staging size is configured for a Rx N-SDU, the payload of the received frames is accumulated in a
+    staging buffer and handed over to PduR_CanTpCopyRxData at the end of each block, at the end of the reception or once
+    the staging buffer is full.
+    """
+
+    @staticmethod
+    def record_copies(handle):
+        sizes = []
+
+        def copy_rx_data(rx_pdu_id, pdu_info, buffer_size):
+            if pdu_info.SduLength != 0:
+                sizes.append(pdu_info.SduLength)
+            return handle._pdu_r_can_tp_copy_rx_data(rx_pdu_id, pdu_info, buffer_size)
+
+        handle.pdu_r_can_tp_copy_rx_data.side_effect = copy_rx_data
+        return sizes
+
+    def test_single_frame(self):
+        handle = CanTpTest(DefaultReceiver(bs=4, staging_size=8))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info([0x04, 1, 2, 3, 4]))
+        handle.pdu_r_can_tp_copy_rx_data.assert_called_once()
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.can_tp_rx_data == [1, 2, 3, 4]
+
+    @pytest.mark.parametrize('bs', (1, 4, 15))
+    def test_one_copy_per_block(self, bs):
+        handle = CanTpTest(DefaultReceiver(bs=bs, staging_size=100))
+        payload = [i & 0xFF for i in range(100)]
+        sizes = self.record_copies(handle)
+        TestZeroCopyReceive.receive(handle, payload, bs)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert len(sizes) == ceil(14 / bs)
+        assert handle.can_tp_rx_data == payload
+
+    def test_copy_when_staging_buffer_full(self):
+        handle = CanTpTest(DefaultReceiver(bs=4, staging_size=16))
+        payload = [i & 0xFF for i in range(100)]
+        sizes = self.record_copies(handle)
+        TestZeroCopyReceive.receive(handle, payload, 4)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_OK'))
+        assert ceil(14 / 4) < len(sizes) < 15
+        assert max(sizes) <= 16
+        assert handle.can_tp_rx_data == payload
+
+    def test_copy_failure_aborts_reception(self):
+        handle = CanTpTest(DefaultReceiver(bs=4, staging_size=100))
+        payload = [i & 0xFF for i in range(100)]
+        handle.pdu_r_can_tp_copy_rx_data.return_value = handle.lib.BUFREQ_E_NOT_OK
+        TestZeroCopyReceive.receive(handle, payload, 4)
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_NOT_OK'))
+
+
+class TestDynamicAddressing:
+    """
+    If dynamic addressing is enabled for an N-SDU using the normal fixed or 29 bits mixed addressing format, N_SA and N_TA
+    are taken from the CAN_ID_32 meta data of the N-PDUs instead of the configuration, and the sessions with each peer run
+    on their own entry of the connection pool.
+    """
+
+    @staticmethod
+    def can_id(n_sa, n_ta):
+        return 0x18DA0000 | (n_ta << 8) | n_sa
+
+    @staticmethod
+    def get_meta_data(can_id):
+        return [(can_id >> shift) & 0xFF for shift in (0, 8, 16, 24)]
+
+    @staticmethod
+    def read_meta_data(pdu_info):
+        return sum(pdu_info.MetaDataPtr[idx] << (idx * 8) for idx in range(4))
+
+    def receive(self, handle, n_sa, n_ta, frame):
+        meta_data = self.get_meta_data(self.can_id(n_sa, n_ta))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(frame, meta_data=meta_data))
+
+    def record_transmits(self, handle):
+        frames = []
+
+        def can_if_transmit(_pdu_id, pdu_info):
+            frames.append((self.read_meta_data(pdu_info), list(pdu_info.SduDataPtr[0:pdu_info.SduLength])))
+            return handle.define('E_OK')
+
+        handle.can_if_transmit.side_effect = can_if_transmit
+        return frames
+
+    def test_single_frames_from_several_peers(self):
+        handle = CanTpTest(DefaultReceiver(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=4))
+        sources = []
+
+        def start_of_reception(_pdu_id, pdu_info, _length, buffer_size):
+            sources.append(self.read_meta_data(pdu_info))
+            buffer_size[0] = 0x0FFF
+            return handle.lib.BUFREQ_OK
+
+        handle.pdu_r_can_tp_start_of_reception.side_effect = start_of_reception
+        for n_sa in (0x10, 0x11, 0x12):
+            self.receive(handle, n_sa, default_n_ta, handle.get_receiver_single_frame((n_sa,) * 4, af='CANTP_NORMALFIXED'))
+        handle.lib.CanTp_MainFunction()
+        assert sources == [self.can_id(n_sa, default_n_ta) for n_sa in (0x10, 0x11, 0x12)]
+        assert handle.pdu_r_can_tp_rx_indication.call_count == 3
+        assert handle.can_tp_rx_data == [0x10] * 4 + [0x11] * 4 + [0x12] * 4
+
+    @pytest.mark.parametrize('af', ('CANTP_NORMALFIXED', 'CANTP_MIXED29BIT'))
+    def test_concurrent_segmented_receptions(self, af):
+        handle = CanTpTest(DefaultReceiver(af=af, dynamic_addressing=True, peer_cnt=2))
+        peers = (0x10, 0x11)
+        payloads = {n_sa: [(n_sa + idx) & 0xFF for idx in range(30)] for n_sa in peers}
+        frames = {n_sa: handle.get_receiver_multi_frame(payloads[n_sa], af=af, bs=2) for n_sa in peers}
+        received = {}
+        fcs = self.record_transmits(handle)
+
+        def copy_rx_data(_pdu_id, pdu_info, buffer_size):
+            data = received.setdefault(self.read_meta_data(pdu_info), [])
+            data += list(pdu_info.SduDataPtr[0:pdu_info.SduLength])
+            buffer_size[0] = 0x0FFF
+            return handle.lib.BUFREQ_OK
+
+        handle.pdu_r_can_tp_copy_rx_data.side_effect = copy_rx_data
+        blocks = {n_sa: [frames[n_sa][1][idx:idx + 2] for idx in range(0, len(frames[n_sa][1]), 2)] for n_sa in peers}
+        confirmed = 0
+        for n_sa in peers:
+            self.receive(handle, n_sa, default_n_ta, frames[n_sa][0])
+        for _ in range(10):
+            handle.lib.CanTp_MainFunction()
+            while confirmed < len(fcs):
+                n_sa = fcs[confirmed][0] >> 8 & 0xFF
+                confirmed += 1
+                handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+                for cf in blocks[n_sa].pop(0):
+                    self.receive(handle, n_sa, default_n_ta, cf)
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_rx_indication.call_count == 2
+        handle.pdu_r_can_tp_rx_indication.assert_called_with(0, handle.define('E_OK'))
+        assert {meta_data for meta_data, _ in fcs} == {self.can_id(default_n_ta, n_sa) for n_sa in peers}
+        assert received == {self.can_id(n_sa, default_n_ta): payloads[n_sa] for n_sa in peers}
+
+    def test_frame_without_meta_data_ignored(self):
+        handle = CanTpTest(DefaultReceiver(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=1))
+        handle.lib.CanTp_RxIndication(0, handle.get_pdu_info(handle.get_receiver_single_frame(af='CANTP_NORMALFIXED')))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_not_called()
+
+    def test_frame_ignored_if_pool_exhausted(self):
+        handle = CanTpTest(DefaultReceiver(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=1))
+        for n_sa in (0x10, 0x11):
+            ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 20, af='CANTP_NORMALFIXED')
+            self.receive(handle, n_sa, default_n_ta, ff)
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_start_of_reception.assert_called_once()
+        handle.can_if_transmit.assert_called_once()
+
+    def test_entry_released_at_end_of_session(self):
+        handle = CanTpTest(DefaultReceiver(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=1))
+        for n_sa in (0x10, 0x11):
+            self.receive(handle, n_sa, default_n_ta, handle.get_receiver_single_frame(af='CANTP_NORMALFIXED'))
+            handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_rx_indication.call_count == 2
+        handle.pdu_r_can_tp_rx_indication.assert_called_with(0, handle.define('E_OK'))
+
+    def test_concurrent_transmissions(self):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=2))
+        peers = (0x10, 0x11)
+        frames = self.record_transmits(handle)
+
+        def copy_tx_data(_pdu_id, pdu_info, _retry, available_data):
+            for idx in range(pdu_info.SduLength):
+                pdu_info.SduDataPtr[idx] = self.read_meta_data(pdu_info) >> 8 & 0xFF
+            available_data[0] = 0x0FFF
+            return handle.lib.BUFREQ_OK
+
+        handle.pdu_r_can_tp_copy_tx_data.side_effect = copy_tx_data
+        for n_ta in peers:
+            pdu_info = handle.get_pdu_info((dummy_byte,) * 20, meta_data=self.get_meta_data(self.can_id(default_n_sa,
+                                                                                                         n_ta)))
+            assert handle.lib.CanTp_Transmit(0, pdu_info) == handle.define('E_OK')
+        confirmed = 0
+        for _ in range(10):
+            handle.lib.CanTp_MainFunction()
+            while confirmed < len(frames):
+                meta_data, frame = frames[confirmed]
+                confirmed += 1
+                handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+                if frame[0] >> 4 == 1:
+                    fc = handle.get_receiver_flow_control(bs=0, af='CANTP_NORMALFIXED')
+                    self.receive(handle, meta_data >> 8 & 0xFF, default_n_sa, fc)
+        assert handle.pdu_r_can_tp_tx_confirmation.call_count == 2
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_with(0, handle.define('E_OK'))
+        for meta_data, frame in frames:
+            assert meta_data >> 8 & 0xFF in peers
+            assert frame[-1] == meta_data >> 8 & 0xFF
+        assert len(frames) == 6
+
+    def test_one_peer_waiting_for_confirmation(self):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=2))
+        frames = self.record_transmits(handle)
+        for n_ta in (0x10, 0x11):
+            meta_data = self.get_meta_data(self.can_id(default_n_sa, n_ta))
+            handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4, meta_data=meta_data))
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_MainFunction()
+        assert len(frames) == 1
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        assert {meta_data for meta_data, _ in frames} == {self.can_id(default_n_sa, n_ta) for n_ta in (0x10, 0x11)}
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        assert handle.pdu_r_can_tp_tx_confirmation.call_count == 2
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_with(0, handle.define('E_OK'))
+
+    def test_cancel_transmit_applies_to_session_of_peer(self):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=2))
+        meta_data = self.get_meta_data(self.can_id(default_n_sa, 0x10))
+        handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 20, meta_data=meta_data))
+        handle.lib.CanTp_MainFunction()
+        assert handle.lib.CanTp_CancelTransmit(0) == handle.define('E_OK')
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_NOT_OK'))
+        handle.det_report_runtime_error.assert_not_called()
+
+    def test_cancel_receive_applies_to_session_of_peer(self):
+        handle = CanTpTest(DefaultReceiver(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=2))
+        ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 20, af='CANTP_NORMALFIXED')
+        self.receive(handle, 0x10, default_n_ta, ff)
+        handle.lib.CanTp_MainFunction()
+        assert handle.lib.CanTp_CancelReceive(0) == handle.define('E_OK')
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0, handle.define('E_NOT_OK'))
+        handle.det_report_runtime_error.assert_not_called()
+
+    def test_cancel_rejected_if_several_peers_have_a_session(self):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=2))
+        for n_ta in (0x10, 0x11):
+            meta_data = self.get_meta_data(self.can_id(default_n_sa, n_ta))
+            handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 20, meta_data=meta_data))
+        assert handle.lib.CanTp_CancelTransmit(0) == handle.define('E_NOT_OK')
+        handle.det_report_runtime_error.assert_called_once_with(ANY, ANY, ANY, handle.define('CANTP_E_AMBIGUOUS_PEER'))
+        handle.pdu_r_can_tp_tx_confirmation.assert_not_called()
+
+    @pytest.mark.parametrize('service, status_type', [('CanTp_GetTxQueueStatus', 'CanTp_TxQueueStatusType *'),
+                                                      ('CanTp_GetTxStallStatus', 'CanTp_TxStallStatusType *')])
+    def test_status_rejected(self, service, status_type):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=1))
+        assert getattr(handle.lib, service)(0, handle.ffi.new(status_type)) == handle.define('E_NOT_OK')
+        handle.det_report_error.assert_called_once_with(ANY, ANY, ANY, handle.define('CANTP_E_PARAM_ID'))
+
+    def test_transmit_rejected_if_pool_exhausted(self):
+        handle = CanTpTest(DefaultSender(af='CANTP_NORMALFIXED', dynamic_addressing=True, peer_cnt=1))
+        for n_ta, result in ((0x10, 'E_OK'), (0x11, 'E_NOT_OK'), (0x10, 'E_NOT_OK')):
+            meta_data = self.get_meta_data(self.can_id(default_n_sa, n_ta))
+            pdu_info = handle.get_pdu_info((dummy_byte,) * 4, meta_data=meta_data)
+            assert handle.lib.CanTp_Transmit(0, pdu_info) == handle.define(result)
+        assert handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_NOT_OK')
+
+    def test_standard_addressing_rejected(self):
+        handle = CanTpTest(DefaultReceiver(dynamic_addressing=True, peer_cnt=1), initialize=False)
+        handle.lib.CanTp_Init(handle.ffi.cast('const CanTp_ConfigType *', handle.config.lib.CanTp_Config))
+        handle.det_report_error.assert_called_once_with(ANY, ANY, ANY, handle.define('CANTP_E_INIT_FAILED'))
+
+
+class TestConnectionPool:
+    """
+    If a reception (resp. transmission) connection pool size is configured, the N-SDUs do not own a dedicated connection:
+    a connection of the pool is bound to an Rx N-SDU on reception of a SF or FF (resp. to a Tx N-SDU on transmit request)
+    and given back at the end of the session. If the pool is exhausted, the N-PDU is ignored (and a FF answered with a
+    FC(OVFLW) if the overflow policy is configured), or the transmit request rejected.
+    """
+
+    @staticmethod
+    def get_status(handle):
+        status = handle.ffi.new('CanTp_ConnectionPoolStatusType *')
+        assert handle.lib.CanTp_GetConnectionPoolStatus(status) == handle.define('E_OK')
+        return status
+
+    def test_single_frames_share_one_connection(self):
+        handle = CanTpTest(DefaultReceiver(n_sdu_cnt=4, pool_size=1))
+        for pdu_id in range(4):
+            handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(handle.get_receiver_single_frame()))
+            handle.lib.CanTp_MainFunction()
+            handle.pdu_r_can_tp_rx_indication.assert_called_with(pdu_id, handle.define('E_OK'))
+        status = self.get_status(handle)
+        assert (status.rx_in_use, status.rx_high_water, status.rx_rejected) == (0, 1, 0)
+
+    def test_first_frame_ignored_if_pool_exhausted(self):
+        handle = CanTpTest(DefaultReceiver(n_sdu_cnt=3, pool_size=2))
+        for pdu_id in range(3):
+            ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 20)
+            handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(ff))
+        handle.lib.CanTp_MainFunction()
+        assert [c[0][0] for c in handle.pdu_r_can_tp_start_of_reception.call_args_list] == [0, 1]
+        assert handle.can_if_transmit.call_count == 2
+        status = self.get_status(handle)
+        assert (status.rx_in_use, status.rx_high_water, status.rx_rejected) == (2, 2, 1)
+
+    def test_overflow_flow_control_if_pool_exhausted(self):
+        handle = CanTpTest(DefaultReceiver(n_sdu_cnt=2, pool_size=1, pool_policy='CANTP_POOL_POLICY_OVERFLOW'))
+        frames = []
+
+        def can_if_transmit(pdu_id, pdu_info):
+            frames.append((pdu_id, pdu_info.SduDataPtr[0]))
+            return handle.define('E_OK')
+
+        handle.can_if_transmit.side_effect = can_if_transmit
+        for pdu_id in range(2):
+            ff, _ = handle.get_receiver_multi_frame((dummy_byte,) * 20)
+            handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(ff))
+        handle.pdu_r_can_tp_start_of_reception.assert_called_once()
+        assert frames == [(1, 0x32)]
+        handle.lib.CanTp_TxConfirmation(1, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_rx_indication.assert_not_called()
+
+    def test_connection_released_at_end_of_session(self):
+        handle = CanTpTest(DefaultReceiver(n_sdu_cnt=2, pool_size=1))
+        for pdu_id in range(2):
+            ff, cfs = handle.get_receiver_multi_frame((dummy_byte,) * 10, bs=0)
+            handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(ff))
+            handle.lib.CanTp_MainFunction()
+            handle.lib.CanTp_TxConfirmation(pdu_id, handle.define('E_OK'))
+            for cf in cfs:
+                handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(cf))
+            handle.lib.CanTp_MainFunction()
+            handle.pdu_r_can_tp_rx_indication.assert_called_with(pdu_id, handle.define('E_OK'))
+        assert self.get_status(handle).rx_in_use == 0
+
+    def test_parameters_kept_without_connection(self):
+        handle = CanTpTest(DefaultReceiver(n_sdu_cnt=2, pool_size=1))
+        value = handle.ffi.new('uint16 *')
+        assert handle.lib.CanTp_ChangeParameter(1, handle.lib.TP_BS, 5) == handle.define('E_OK')
+        handle.lib.CanTp_RxIndication(1, handle.get_pdu_info(handle.get_receiver_single_frame()))
+        handle.lib.CanTp_MainFunction()
+        assert handle.lib.CanTp_ReadParameter(1, handle.lib.TP_BS, value) == handle.define('E_OK')
+        assert value[0] == 5
+
+    def test_transmit_rejected_if_pool_exhausted(self):
+        handle = CanTpTest(DefaultSender(n_sdu_cnt=2, pool_size=1))
+        assert handle.lib.CanTp_Transmit(0, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_OK')
+        assert handle.lib.CanTp_Transmit(1, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_NOT_OK')
+        handle.lib.CanTp_MainFunction()
+        handle.lib.CanTp_TxConfirmation(0, handle.define('E_OK'))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_tx_confirmation.assert_called_once_with(0, handle.define('E_OK'))
+        assert handle.lib.CanTp_Transmit(1, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_OK')
+        status = self.get_status(handle)
+        assert (status.tx_in_use, status.tx_high_water, status.tx_rejected) == (1, 1, 1)
+
+    def test_staging_rejected_by_init(self):
+        handle = CanTpTest(DefaultReceiver(staging_size=8, pool_size=1), initialize=False)
+        handle.lib.CanTp_Init(handle.ffi.cast('const CanTp_ConfigType *', handle.config.lib.CanTp_Config))
+        handle.det_report_error.assert_called_once_with(ANY, ANY, ANY, handle.define('CANTP_E_INIT_FAILED'))
+
+    def test_transmit_window_rejected_by_init(self):
+        handle = CanTpTest(DefaultSender(window=2, pool_size=1), initialize=False)
+        handle.lib.CanTp_Init(handle.ffi.cast('const CanTp_ConfigType *', handle.config.lib.CanTp_Config))
+        handle.det_report_error.assert_called_once_with(ANY, ANY, ANY, handle.define('CANTP_E_INIT_FAILED'))
+
+
+class TestPduIdMap:
+    """
+    The configuration generator emits a table indexed by PduId giving the channel and runtime slot of each N-SDU, so
+    the N-SDU identifiers do not have to match the runtime slot indices and may be sparse.
+    """
+
+    @staticmethod
+    def get_sparse_config():
+        config = DefaultFullDuplex()
+        channel = config['configurations'][0]['channels'][0]
+        sender = channel.pop('transmitters')[0]
+        sender['network_service_data_unit_identifier'] = 0x0123
+        channel['receivers'][0]['network_service_data_unit_identifier'] = 0x0045
+        config['configurations'][0]['channels'].append({'channel_mode': 'CANTP_MODE_HALF_DUPLEX',
+                                                        'transmitters': [sender]})
+        return config
+
+    def test_sparse_transmitter(self):
+        handle = CanTpTest(self.get_sparse_config())
+        assert handle.lib.CanTp_Transmit(0x0123, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_OK')
+        handle.lib.CanTp_MainFunction()
+        assert handle.can_if_transmit.call_count == 1
+
+    def test_sparse_receiver(self):
+        handle = CanTpTest(self.get_sparse_config())
+        handle.lib.CanTp_RxIndication(0x0045, handle.get_pdu_info(handle.get_receiver_single_frame((dummy_byte,) * 4)))
+        handle.lib.CanTp_MainFunction()
+        handle.pdu_r_can_tp_rx_indication.assert_called_once_with(0x0045, handle.define('E_OK'))
+
+    @pytest.mark.parametrize('pdu_id', (0x0000, 0x0045, 0x0122, 0x0124, 0xFFFF))
+    def test_unknown_transmitter(self, pdu_id):
+        handle = CanTpTest(self.get_sparse_config())
+        assert handle.lib.CanTp_Transmit(pdu_id, handle.get_pdu_info((dummy_byte,) * 4)) == handle.define('E_NOT_OK')
+        handle.lib.CanTp_MainFunction()
+        handle.can_if_transmit.assert_not_called()
+
+    def test_map_starts_at_lowest_identifier(self):
+        handle = CanTpTest(self.get_sparse_config())
+        assert handle.config.lib.CanTp_Config[0].pduIdMapBase == 0x0045
+        assert handle.config.lib.CanTp_Config[0].pduIdMapSize == 0x0123 - 0x0045 + 1
+
+    @pytest.mark.parametrize('n_sdu_cnt', (16, 4096))
+    def test_large_sparse_configuration(self, n_sdu_cnt):
+        config = DefaultReceiver()
+        receiver = config.receivers.pop()
+        pdu_ids = [0x1000 + idx * 7 for idx in range(n_sdu_cnt)]
+        for pdu_id in pdu_ids:
+            config.receivers.append(dict(receiver, network_service_data_unit_identifier=pdu_id))
+        handle = CanTpTest(config)
+        for pdu_id in (pdu_ids[0], pdu_ids[-1]):
+            handle.lib.CanTp_RxIndication(pdu_id, handle.get_pdu_info(handle.get_receiver_single_frame()))
+            handle.lib.CanTp_MainFunction()
+            handle.pdu_r_can_tp_rx_indication.assert_called_with(pdu_id, handle.define('E_OK'))
+        handle.lib.CanTp_RxIndication(pdu_ids[0] + 1, handle.get_pdu_info(handle.get_receiver_single_frame()))
+        assert handle.pdu_r_can_tp_rx_indication.call_count == 2
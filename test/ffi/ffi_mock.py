@@ -142,6 +142,7 @@ class CanTpTest(object):
         self.available_rx_buffer = rx_buffer_size
         self.can_if_tx_data = list()
         self.can_tp_rx_data = list()
+        self.meta_data = list()
         code_gen = CodeGen(config)
         with open(os.path.join(build_directory, 'CanTp_PBcfg.h'), 'w') as fp:
             fp.write(code_gen.header)
@@ -212,7 +213,9 @@ class CanTpTest(object):
         pdu_info.SduDataPtr = sdu_data
         pdu_info.SduLength = sdu_length
         if meta_data:
-            raise NotImplementedError
+            meta_data = self.code.ffi.new('uint8 []', list(meta_data))
+            self.meta_data.append(meta_data)
+            pdu_info.MetaDataPtr = meta_data
         else:
             pdu_info.MetaDataPtr = self.code.ffi.NULL
         return pdu_info
@@ -45,6 +45,19 @@ class Config(dict):
     def get_id(self):
         return hashlib.sha224(json.dumps(self, sort_keys=True, indent=0).encode('utf-8')).hexdigest()[0:8]
 
+    def set_options(self, n_sdus, n_sdu_options, configuration_options, n_sdu_cnt):
+        """
+        sets the optional parameters of the N-SDU and of the configuration whose value is not None, the others keep their
+        default value, and replicates the N-SDU n_sdu_cnt times with consecutive identifiers.
+        """
+        n_sdu = n_sdus.pop()
+        n_sdu.update({key: value for key, value in n_sdu_options.items() if value is not None})
+        for idx in range(n_sdu_cnt):
+            n_sdus.append(dict(n_sdu,
+                               network_service_data_unit_identifier=idx,
+                               network_service_data_unit_reference=idx))
+        self['configurations'][0].update({key: value for key, value in configuration_options.items() if value is not None})
+
 
 class DefaultReceiver(Config):
     def __init__(self,
@@ -61,7 +74,17 @@ class DefaultReceiver(Config):
                  padding=None,
                  n_sa=default_n_sa,
                  n_ta=default_n_ta,
-                 n_ae=default_n_ae):
+                 n_ae=default_n_ae,
+                 processing_mode=None,
+                 rx_dl=None,
+                 staging_size=None,
+                 retry=None,
+                 buffer_notification=None,
+                 dynamic_addressing=None,
+                 peer_cnt=None,
+                 pool_size=None,
+                 pool_policy=None,
+                 n_sdu_cnt=1):
         super(DefaultReceiver, self).__init__({
             "configurations": [
                 {
@@ -93,6 +116,18 @@ class DefaultReceiver(Config):
                 }
             ]
         })
+        if processing_mode is not None:
+            self['configurations'][0]['channels'][0]['processing_mode'] = processing_mode
+        self.set_options(self.receivers,
+                         {'rx_data_length': rx_dl,
+                          'receive_staging_size': staging_size,
+                          'enable_transmit_retry': retry,
+                          'enable_buffer_notification': buffer_notification,
+                          'enable_dynamic_addressing': dynamic_addressing},
+                         {'peer_connection_count': peer_cnt,
+                          'rx_connection_pool_size': pool_size,
+                          'connection_pool_policy': pool_policy},
+                         n_sdu_cnt)
 
     @property
     def main_period(self):
@@ -115,7 +150,19 @@ class DefaultSender(Config):
                  padding=None,
                  n_sa=default_n_sa,
                  n_ta=default_n_ta,
-                 n_ae=default_n_ae):
+                 n_ae=default_n_ae,
+                 processing_mode=None,
+                 tx_dl=None,
+                 staging_size=None,
+                 retry=None,
+                 data_notification=None,
+                 window=None,
+                 queue_depth=None,
+                 burst_size=None,
+                 dynamic_addressing=None,
+                 peer_cnt=None,
+                 pool_size=None,
+                 n_sdu_cnt=1):
         super(DefaultSender, self).__init__({
             "configurations": [
                 {
@@ -144,6 +191,20 @@ class DefaultSender(Config):
                 }
             ]
         })
+        if processing_mode is not None:
+            self['configurations'][0]['channels'][0]['processing_mode'] = processing_mode
+        self.set_options(self.senders,
+                         {'tx_data_length': tx_dl,
+                          'transmit_staging_size': staging_size,
+                          'enable_transmit_retry': retry,
+                          'enable_data_notification': data_notification,
+                          'transmit_window': window,
+                          'transmit_queue_depth': queue_depth,
+                          'burst_size': burst_size,
+                          'enable_dynamic_addressing': dynamic_addressing},
+                         {'peer_connection_count': peer_cnt,
+                          'tx_connection_pool_size': pool_size},
+                         n_sdu_cnt)
 
     @property
     def main_period(self):